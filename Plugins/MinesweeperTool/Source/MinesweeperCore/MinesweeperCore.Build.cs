@@ -0,0 +1,20 @@
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// The game, solver and storage, with no editor or engine dependencies, so packaged builds,
+// commandlets and dedicated servers can run games and simulations
+public class MinesweeperCore : ModuleRules
+{
+	public MinesweeperCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core"
+			}
+			);
+	}
+}
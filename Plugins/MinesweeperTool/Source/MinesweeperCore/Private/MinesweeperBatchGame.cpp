@@ -0,0 +1,347 @@
+// MinesweeperBatchGame.cpp
+#include "MinesweeperBatchGame.h"
+#include "Math/UnrealMathUtility.h"
+#include "Math/RandomStream.h"
+
+FMinesweeperBatchGame::FMinesweeperBatchGame()
+    : Width(0)
+    , Height(0)
+    , BombCount(0)
+    , GeneratedMask(0)
+    , GameOverMask(0)
+    , GameWonMask(0)
+{
+    FMemory::Memzero(Seeds, sizeof(Seeds));
+}
+
+void FMinesweeperBatchGame::NewGames(int32 InWidth, int32 InHeight, int32 InBombCount, TArrayView<const int32> InSeeds)
+{
+    check(InSeeds.Num() == NumBoards);
+
+    // Same validation as FMinesweeperGame::NewGame
+    Width = FMath::Max(1, InWidth);
+    Height = FMath::Max(1, InHeight);
+
+    const int32 MaxBombs = (Width * Height) - 1;
+    BombCount = FMath::Clamp(InBombCount, 0, MaxBombs);
+
+    for (int32 Board = 0; Board < NumBoards; ++Board)
+    {
+        Seeds[Board] = InSeeds[Board];
+    }
+
+    GeneratedMask = 0;
+    GameOverMask = 0;
+    GameWonMask = 0;
+
+    // Reset planes, keeping their allocations between batches
+    const int32 NumCells = Width * Height;
+    auto ResetPlane = [NumCells](TArray<uint64>& Plane)
+    {
+        Plane.SetNumUninitialized(NumCells);
+        FMemory::Memzero(Plane.GetData(), NumCells * sizeof(uint64));
+    };
+
+    ResetPlane(BombPlane);
+    ResetPlane(RevealedPlane);
+    ResetPlane(ExplodedPlane);
+    ResetPlane(ZeroPlane);
+    ResetPlane(PendingPlane);
+    for (TArray<uint64>& CountPlane : CountPlanes)
+    {
+        ResetPlane(CountPlane);
+    }
+
+    PendingCells.Reset();
+}
+
+void FMinesweeperBatchGame::RevealTile(int32 X, int32 Y, uint64 BoardMask)
+{
+    if (!IsValidCoordinate(X, Y))
+    {
+        return;
+    }
+
+    int32 TileIndices[NumBoards];
+    for (int32 Board = 0; Board < NumBoards; ++Board)
+    {
+        TileIndices[Board] = ((BoardMask >> Board) & 1) ? Y * Width + X : INDEX_NONE;
+    }
+
+    RevealTiles(MakeArrayView(TileIndices, NumBoards));
+}
+
+void FMinesweeperBatchGame::RevealTiles(TArrayView<const int32> TileIndices)
+{
+    check(TileIndices.Num() == NumBoards);
+
+    const int32 NumCells = Width * Height;
+
+    // Finished boards ignore further clicks, like the window does
+    uint64 ActiveMask = 0;
+    for (int32 Board = 0; Board < NumBoards; ++Board)
+    {
+        const int32 Cell = TileIndices[Board];
+        if (Cell >= 0 && Cell < NumCells)
+        {
+            ActiveMask |= 1ull << Board;
+        }
+    }
+    ActiveMask &= ~GetFinishedMask();
+
+    if (ActiveMask == 0)
+    {
+        return;
+    }
+
+    // First click on a board - place its bombs keeping the clicked tile safe
+    const uint64 FirstClickMask = ActiveMask & ~GeneratedMask;
+    if (FirstClickMask != 0)
+    {
+        PlaceBombs(FirstClickMask, TileIndices.GetData());
+        CalculateAdjacentBombs();
+    }
+
+    // Reveal the clicked tile on every active board
+    uint64 ExplodedMask = 0;
+    for (uint64 Remaining = ActiveMask; Remaining != 0; Remaining &= Remaining - 1)
+    {
+        const int32 Board = FMath::CountTrailingZeros64(Remaining);
+        const uint64 BoardBit = 1ull << Board;
+        const int32 Cell = TileIndices[Board];
+
+        // If tile is already revealed, do nothing
+        if ((RevealedPlane[Cell] | ExplodedPlane[Cell]) & BoardBit)
+        {
+            continue;
+        }
+
+        if (BombPlane[Cell] & BoardBit)
+        {
+            ExplodedPlane[Cell] |= BoardBit;
+            ExplodedMask |= BoardBit;
+            continue;
+        }
+
+        RevealedPlane[Cell] |= BoardBit;
+
+        // If this is an empty tile, queue it so the flood fill expands it
+        if (ZeroPlane[Cell] & BoardBit)
+        {
+            if (PendingPlane[Cell] == 0)
+            {
+                PendingCells.Add(Cell);
+            }
+            PendingPlane[Cell] |= BoardBit;
+        }
+    }
+
+    // Game over - reveal all remaining bombs of the exploded boards in one sweep
+    if (ExplodedMask != 0)
+    {
+        GameOverMask |= ExplodedMask;
+        for (int32 Cell = 0; Cell < NumCells; ++Cell)
+        {
+            RevealedPlane[Cell] |= BombPlane[Cell] & ExplodedMask & ~ExplodedPlane[Cell];
+        }
+    }
+
+    FloodFillReveal();
+
+    CheckGamesWon(ActiveMask & ~ExplodedMask);
+}
+
+bool FMinesweeperBatchGame::IsValidCoordinate(int32 X, int32 Y) const
+{
+    return X >= 0 && X < Width && Y >= 0 && Y < Height;
+}
+
+FMinesweeperGame::FTile FMinesweeperBatchGame::GetTile(int32 Board, int32 X, int32 Y) const
+{
+    FMinesweeperGame::FTile Tile;
+    if (!IsValidCoordinate(X, Y) || Board < 0 || Board >= NumBoards)
+    {
+        return Tile;
+    }
+
+    const int32 Cell = Y * Width + X;
+    const uint64 BoardBit = 1ull << Board;
+
+    Tile.bIsBomb = (BombPlane[Cell] & BoardBit) != 0;
+    for (int32 Bit = 0; Bit < int32(UE_ARRAY_COUNT(CountPlanes)); ++Bit)
+    {
+        if (CountPlanes[Bit][Cell] & BoardBit)
+        {
+            Tile.AdjacentBombs |= 1 << Bit;
+        }
+    }
+
+    if (ExplodedPlane[Cell] & BoardBit)
+    {
+        Tile.State = FMinesweeperGame::ETileState::Exploded;
+    }
+    else if (RevealedPlane[Cell] & BoardBit)
+    {
+        Tile.State = FMinesweeperGame::ETileState::Revealed;
+    }
+
+    return Tile;
+}
+
+void FMinesweeperBatchGame::PlaceBombs(uint64 BoardMask, const int32* SafeIndices)
+{
+    // Every board runs the same partial Fisher-Yates shuffle as FMinesweeperGame::GenerateBombIndices,
+    // so it matches the scalar game for its seed. The boards share one list of tile ranks: rank R stands
+    // for tile R, or R + 1 past the board's safe tile, which is the order the scalar list is built in.
+    // Each board's swaps are undone afterwards, so setup costs the bomb count per board instead of
+    // rebuilding and shuffling a list of every tile.
+    const int32 NumRanks = Width * Height - 1;
+    if (ShuffleTiles.Num() != NumRanks)
+    {
+        ShuffleTiles.SetNumUninitialized(NumRanks);
+        for (int32 Rank = 0; Rank < NumRanks; ++Rank)
+        {
+            ShuffleTiles[Rank] = Rank;
+        }
+    }
+
+    const int32 BombsToPlace = FMath::Min(BombCount, NumRanks);
+    ShuffleSwaps.SetNumUninitialized(BombsToPlace);
+    for (uint64 Remaining = BoardMask; Remaining != 0; Remaining &= Remaining - 1)
+    {
+        const int32 Board = FMath::CountTrailingZeros64(Remaining);
+        const uint64 BoardBit = 1ull << Board;
+        const int32 SafeIndex = SafeIndices[Board];
+
+        FRandomStream RandomStream(Seeds[Board]);
+        for (int32 i = 0; i < BombsToPlace; ++i)
+        {
+            const int32 RandomIndex = RandomStream.RandRange(i, NumRanks - 1);
+            ShuffleTiles.Swap(i, RandomIndex);
+            ShuffleSwaps[i] = RandomIndex;
+
+            const int32 Rank = ShuffleTiles[i];
+            BombPlane[Rank < SafeIndex ? Rank : Rank + 1] |= BoardBit;
+        }
+
+        // Put the ranks back in order for the next board
+        for (int32 i = BombsToPlace - 1; i >= 0; --i)
+        {
+            ShuffleTiles.Swap(i, ShuffleSwaps[i]);
+        }
+    }
+
+    GeneratedMask |= BoardMask;
+}
+
+void FMinesweeperBatchGame::CalculateAdjacentBombs()
+{
+    for (int32 Y = 0; Y < Height; ++Y)
+    {
+        for (int32 X = 0; X < Width; ++X)
+        {
+            // Bit-sliced ripple counter: bit N of Count0..Count3 is the 4-bit count of board N
+            uint64 Count0 = 0;
+            uint64 Count1 = 0;
+            uint64 Count2 = 0;
+            uint64 Count3 = 0;
+
+            // Check all 8 surrounding tiles
+            for (int32 DY = -1; DY <= 1; ++DY)
+            {
+                for (int32 DX = -1; DX <= 1; ++DX)
+                {
+                    if ((DX == 0 && DY == 0) || !IsValidCoordinate(X + DX, Y + DY))
+                    {
+                        continue;
+                    }
+
+                    uint64 Carry = BombPlane[(Y + DY) * Width + (X + DX)];
+                    uint64 NextCarry = Count0 & Carry;
+                    Count0 ^= Carry;
+                    Carry = NextCarry;
+                    NextCarry = Count1 & Carry;
+                    Count1 ^= Carry;
+                    Carry = NextCarry;
+                    NextCarry = Count2 & Carry;
+                    Count2 ^= Carry;
+                    Count3 |= NextCarry;
+                }
+            }
+
+            // Bombs keep an adjacent count of zero, as in FMinesweeperGame
+            const int32 Cell = Y * Width + X;
+            const uint64 SafeMask = ~BombPlane[Cell];
+            CountPlanes[0][Cell] = Count0 & SafeMask;
+            CountPlanes[1][Cell] = Count1 & SafeMask;
+            CountPlanes[2][Cell] = Count2 & SafeMask;
+            CountPlanes[3][Cell] = Count3 & SafeMask;
+            ZeroPlane[Cell] = SafeMask & ~(Count0 | Count1 | Count2 | Count3);
+        }
+    }
+}
+
+void FMinesweeperBatchGame::FloodFillReveal()
+{
+    // BFS over cells; each step expands the cell on every board that queued it
+    for (int32 Head = 0; Head < PendingCells.Num(); ++Head)
+    {
+        const int32 Cell = PendingCells[Head];
+        const uint64 ExpandMask = PendingPlane[Cell];
+        PendingPlane[Cell] = 0;
+
+        const int32 CurrentX = Cell % Width;
+        const int32 CurrentY = Cell / Width;
+
+        // Check all 8 surrounding tiles
+        for (int32 DY = -1; DY <= 1; ++DY)
+        {
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                const int32 CheckX = CurrentX + DX;
+                const int32 CheckY = CurrentY + DY;
+
+                if (!IsValidCoordinate(CheckX, CheckY))
+                {
+                    continue;
+                }
+
+                // Only hidden, non-bomb tiles get revealed
+                const int32 CheckCell = CheckY * Width + CheckX;
+                const uint64 NewlyRevealed = ExpandMask & ~RevealedPlane[CheckCell] & ~BombPlane[CheckCell];
+                if (NewlyRevealed == 0)
+                {
+                    continue;
+                }
+
+                RevealedPlane[CheckCell] |= NewlyRevealed;
+
+                // Empty tiles keep the flood going on the boards that just revealed them
+                const uint64 NewlyEmpty = NewlyRevealed & ZeroPlane[CheckCell];
+                if (NewlyEmpty != 0)
+                {
+                    if (PendingPlane[CheckCell] == 0)
+                    {
+                        PendingCells.Add(CheckCell);
+                    }
+                    PendingPlane[CheckCell] |= NewlyEmpty;
+                }
+            }
+        }
+    }
+
+    PendingCells.Reset();
+}
+
+void FMinesweeperBatchGame::CheckGamesWon(uint64 BoardMask)
+{
+    // A board is won when every tile is either revealed or a bomb
+    uint64 WonMask = BoardMask;
+    const int32 NumCells = Width * Height;
+    for (int32 Cell = 0; Cell < NumCells && WonMask != 0; ++Cell)
+    {
+        WonMask &= RevealedPlane[Cell] | BombPlane[Cell];
+    }
+
+    GameWonMask |= WonMask;
+}
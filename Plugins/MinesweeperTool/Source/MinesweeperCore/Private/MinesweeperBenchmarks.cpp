@@ -0,0 +1,429 @@
+// MinesweeperBenchmarks.cpp
+// Console commands that time and check FMinesweeperGame: undo history, paging, storage layouts,
+// board checksums, read snapshots and the 64-board batch game
+#include "MinesweeperGame.h"
+#include "MinesweeperBatchGame.h"
+#include "Math/RandomStream.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Async/Async.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperBenchmarks, Log, All);
+
+static FAutoConsoleCommand UndoBenchmarkCommand(
+    TEXT("Minesweeper.Bench.Undo"),
+    TEXT("Report undo history memory against depth, then time undoing and redoing every move. Usage: Minesweeper.Bench.Undo [Size=2000] [Moves=20000]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 Size = Args.Num() > 0 ? FMath::Max(8, FCString::Atoi(*Args[0])) : 2000;
+        const int32 Moves = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20000;
+        const int32 ReportEvery = FMath::Max(1, Moves / 10);
+
+        FMinesweeperGame Game;
+        Game.NewGame(Size, Size, Size * Size / 8, 1);
+        FRandomStream RandomStream(1);
+
+        UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("Undo history on a %dx%d board:"), Size, Size);
+
+        // Reveal random safe tiles, so every move is undoable and the game keeps going
+        int32 Attempts = 0;
+        while (Game.GetUndoDepth() < Moves && !Game.IsGameWon() && Attempts++ < Moves * 100)
+        {
+            const int32 X = RandomStream.RandRange(0, Size - 1);
+            const int32 Y = RandomStream.RandRange(0, Size - 1);
+            if (Game.GetMoveCount() > 0 && Game.GetTile(X, Y).bIsBomb)
+            {
+                continue;
+            }
+
+            if (Game.RevealTile(X, Y) && Game.GetUndoDepth() % ReportEvery == 0)
+            {
+                const int64 BoardBytes = Game.GetBoardAllocatedSize();
+                const int64 HistoryBytes = Game.GetHistoryAllocatedSize();
+                UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("  depth %6d: history %8.2f MB (%6.0f bytes/move), full copies would take %9.1f MB"),
+                    Game.GetUndoDepth(), HistoryBytes / (1024.0 * 1024.0), double(HistoryBytes) / Game.GetUndoDepth(),
+                    double(BoardBytes) * Game.GetUndoDepth() / (1024.0 * 1024.0));
+            }
+        }
+
+        const int32 Depth = Game.GetUndoDepth();
+        const double UndoStart = FPlatformTime::Seconds();
+        while (Game.Undo())
+        {
+        }
+        const double RedoStart = FPlatformTime::Seconds();
+        while (Game.Redo())
+        {
+        }
+        const double RedoEnd = FPlatformTime::Seconds();
+
+        UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("Undo all %d moves: %.2f us per move, redo all: %.2f us per move"),
+            Depth, (RedoStart - UndoStart) * 1e6 / FMath::Max(1, Depth), (RedoEnd - RedoStart) * 1e6 / FMath::Max(1, Depth));
+    }));
+
+static FAutoConsoleCommand PagingBenchmarkCommand(
+    TEXT("Minesweeper.Bench.Paging"),
+    TEXT("Play random reveals on a paged board and report the chunk cache. Usage: Minesweeper.Bench.Paging [Side=8192] [CapMB=16] [Moves=2000]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 Side = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 64, 46340) : 8192;
+        const int64 CapBytes = int64(Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 16) * 1024 * 1024;
+        const int32 Moves = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 2000;
+
+        FMinesweeperGame Game;
+        Game.NewPagedGame(Side, Side, int32(int64(Side) * Side * 3 / 20), 1, CapBytes);
+
+        const double FirstClickStart = FPlatformTime::Seconds();
+        Game.RevealTile(Side / 2, Side / 2);
+        const double FirstClickEnd = FPlatformTime::Seconds();
+        const FMinesweeperGame::FPagingStats Generated = Game.GetPagingStats();
+
+        // Reveal random safe tiles; each one reads its neighborhood and usually floods a small area
+        FRandomStream RandomStream(1);
+        int32 Reveals = 0;
+        for (int32 Attempt = 0; Attempt < Moves * 100 && Reveals < Moves && !Game.IsGameWon(); ++Attempt)
+        {
+            const int32 X = RandomStream.RandRange(0, Side - 1);
+            const int32 Y = RandomStream.RandRange(0, Side - 1);
+            const FMinesweeperGame::FTile Tile = Game.GetTile(X, Y);
+            if (!Tile.bIsBomb && Tile.State == FMinesweeperGame::ETileState::Hidden)
+            {
+                Game.RevealTile(X, Y);
+                Reveals++;
+            }
+        }
+        const double PlayEnd = FPlatformTime::Seconds();
+
+        const FMinesweeperGame::FPagingStats Stats = Game.GetPagingStats();
+        const uint64 Accesses = (Stats.Hits - Generated.Hits) + (Stats.Misses - Generated.Misses);
+        UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("Paged %dx%d board, cap %.1f MB (%d chunks)"),
+            Side, Side, CapBytes / (1024.0 * 1024.0), Stats.MaxResidentChunks);
+        UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("  generate: %.2f s, %llu page-outs"), FirstClickEnd - FirstClickStart, (unsigned long long)Generated.PageOuts);
+        UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("  %d reveals: %.2f s, %llu chunk accesses, hit rate %.2f%%, %llu page-ins, %llu page-outs"),
+            Reveals, PlayEnd - FirstClickEnd, (unsigned long long)Accesses,
+            100.0 * double(Stats.Hits - Generated.Hits) / double(FMath::Max<uint64>(1, Accesses)),
+            (unsigned long long)(Stats.PageIns - Generated.PageIns), (unsigned long long)(Stats.PageOuts - Generated.PageOuts));
+        UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("  resident: %d chunks, %.1f MB in memory"),
+            Stats.ResidentChunks, Game.GetBoardAllocatedSize() / (1024.0 * 1024.0));
+    }));
+
+// Times the board generation and flood fill passes directly, without the rest of a move
+class FMinesweeperLayoutBenchmark
+{
+public:
+    struct FTimings
+    {
+        double AdjacencySeconds = 0.0;
+        double FloodFillSeconds = 0.0;
+        int32 FloodedTiles = 0;
+    };
+
+    static FTimings Run(FMinesweeperGame::EBoardLayout Layout, int32 Side, int32 BombCount, int32 Repeats)
+    {
+        FTimings Best;
+        Best.AdjacencySeconds = Best.FloodFillSeconds = MAX_dbl;
+
+        for (int32 Repeat = 0; Repeat < Repeats; ++Repeat)
+        {
+            FMinesweeperGame Game;
+            Game.NewGame(Side, Side, BombCount, 1, Layout);
+            Game.PlaceBombsRandomly(Side / 2, Side / 2);
+
+            // Every tile reads its eight neighbors
+            const double AdjacencyStart = FPlatformTime::Seconds();
+            Game.CalculateAdjacentBombs();
+            const double AdjacencyEnd = FPlatformTime::Seconds();
+
+            // Flood from the zero tile nearest the middle; both layouts hold the same board
+            int32 StartX = Side / 2;
+            const int32 StartY = Side / 2;
+            while (StartX < Side - 1 && (Game.GetTile(StartX, StartY).bIsBomb || Game.GetTile(StartX, StartY).AdjacentBombs != 0))
+            {
+                StartX++;
+            }
+
+            Game.Scratch.FloodQueue.Reset();
+            Game.Scratch.FloodQueue.Add(TPair<int32, int32>(StartX, StartY));
+            const double FloodStart = FPlatformTime::Seconds();
+            Game.FloodFillReveal(nullptr);
+            const double FloodEnd = FPlatformTime::Seconds();
+
+            Best.AdjacencySeconds = FMath::Min(Best.AdjacencySeconds, AdjacencyEnd - AdjacencyStart);
+            Best.FloodFillSeconds = FMath::Min(Best.FloodFillSeconds, FloodEnd - FloodStart);
+            Best.FloodedTiles = Game.RevealedTiles;
+        }
+
+        return Best;
+    }
+};
+
+static FAutoConsoleCommand LayoutBenchmarkCommand(
+    TEXT("Minesweeper.Bench.Layout"),
+    TEXT("Compare row-major and tiled storage for adjacency counting and flood fill. Usage: Minesweeper.Bench.Layout [Side=4096] [Repeats=3]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 Side = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 64, 16384) : 4096;
+        const int32 Repeats = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 3;
+
+        // Sparse enough that one flood opens most of the board
+        const int32 BombCount = Side * Side / 25;
+
+        UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("Layouts on a %dx%d board with %d bombs, best of %d:"), Side, Side, BombCount, Repeats);
+        for (const FMinesweeperGame::EBoardLayout Layout : { FMinesweeperGame::EBoardLayout::RowMajor, FMinesweeperGame::EBoardLayout::Tiled })
+        {
+            const FMinesweeperLayoutBenchmark::FTimings Timings = FMinesweeperLayoutBenchmark::Run(Layout, Side, BombCount, Repeats);
+            UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("  %-9s adjacency %7.1f ms (%5.2f ns/tile), flood fill %7.1f ms over %d tiles (%5.2f ns/tile)"),
+                Layout == FMinesweeperGame::EBoardLayout::Tiled ? TEXT("Tiled") : TEXT("RowMajor"),
+                Timings.AdjacencySeconds * 1000.0, Timings.AdjacencySeconds * 1e9 / (double(Side) * Side),
+                Timings.FloodFillSeconds * 1000.0, Timings.FloodedTiles, Timings.FloodFillSeconds * 1e9 / FMath::Max(1, Timings.FloodedTiles));
+        }
+    }));
+
+static FAutoConsoleCommand BoardChecksumCommand(
+    TEXT("Minesweeper.BoardChecksum"),
+    TEXT("Print a hash of the mines a seed places after a first click, to check that two builds generate the same boards. Usage: Minesweeper.BoardChecksum [Width=30] [Height=16] [Bombs=99] [Seed=1] [X=0] [Y=0]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 Width = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 30;
+        const int32 Height = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 16;
+        const int32 BombCount = Args.Num() > 2 ? FMath::Clamp(FCString::Atoi(*Args[2]), 0, Width * Height - 1) : 99;
+        const int32 Seed = Args.Num() > 3 ? FCString::Atoi(*Args[3]) : 1;
+        const int32 FirstX = Args.Num() > 4 ? FMath::Clamp(FCString::Atoi(*Args[4]), 0, Width - 1) : 0;
+        const int32 FirstY = Args.Num() > 5 ? FMath::Clamp(FCString::Atoi(*Args[5]), 0, Height - 1) : 0;
+
+        FMinesweeperGame Game;
+        Game.NewGame(Width, Height, BombCount, Seed);
+        Game.RevealTile(FirstX, FirstY);
+
+        // FNV-1a over the mine positions in row-major order, so the storage layout does not matter
+        uint64 Hash = 14695981039346656037ull;
+        for (int32 Y = 0; Y < Height; ++Y)
+        {
+            for (int32 X = 0; X < Width; ++X)
+            {
+                if (Game.GetTile(X, Y).bIsBomb)
+                {
+                    for (const int32 Value : { X, Y })
+                    {
+                        Hash = (Hash ^ uint32(Value)) * 1099511628211ull;
+                    }
+                }
+            }
+        }
+
+        UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("Board %dx%d, %d bombs, seed %d, first click (%d, %d): checksum %016llx"),
+            Width, Height, BombCount, Seed, FirstX, FirstY, (unsigned long long)Hash);
+    }));
+
+// Problems a reader can see in a read snapshot: flag counters that disagree with the flags,
+// or an empty revealed tile whose flood fill stopped short
+static int32 CountReadSnapshotErrors(const FMinesweeperGame& Snapshot)
+{
+    int32 Errors = 0;
+    int32 Flags = 0;
+    
+    for (int32 Y = 0; Y < Snapshot.GetHeight(); ++Y)
+    {
+        for (int32 X = 0; X < Snapshot.GetWidth(); ++X)
+        {
+            const FMinesweeperGame::FTile Tile = Snapshot.GetTile(X, Y);
+            Flags += Tile.bIsFlagged;
+            
+            int32 FlaggedNeighbors = 0;
+            bool bFloodComplete = true;
+            for (int32 DY = -1; DY <= 1; ++DY)
+            {
+                for (int32 DX = -1; DX <= 1; ++DX)
+                {
+                    if ((DX != 0 || DY != 0) && Snapshot.IsValidCoordinate(X + DX, Y + DY))
+                    {
+                        const FMinesweeperGame::FTile Neighbor = Snapshot.GetTile(X + DX, Y + DY);
+                        FlaggedNeighbors += Neighbor.bIsFlagged;
+                        bFloodComplete &= Neighbor.bIsFlagged || Neighbor.State != FMinesweeperGame::ETileState::Hidden;
+                    }
+                }
+            }
+            
+            const bool bEmpty = Tile.State == FMinesweeperGame::ETileState::Revealed && !Tile.bIsBomb && Tile.AdjacentBombs == 0;
+            Errors += FlaggedNeighbors != Tile.FlaggedNeighbors;
+            Errors += bEmpty && !bFloodComplete;
+        }
+    }
+    
+    return Errors + (Flags != Snapshot.GetFlagCount());
+}
+
+static FAutoConsoleCommand ReadSnapshotStressCommand(
+    TEXT("Minesweeper.Stress.ReadSnapshots"),
+    TEXT("Play random moves while reader threads check every read snapshot they get. The standalone build runs it under ctest, and with MINESWEEPER_TSAN under the thread sanitizer. Usage: Minesweeper.Stress.ReadSnapshots [Seconds=5] [Readers=4] [Side=96]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const double Seconds = Args.Num() > 0 ? FMath::Max(0.1, FCString::Atod(*Args[0])) : 5.0;
+        const int32 NumReaders = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 64) : 4;
+        const int32 Side = Args.Num() > 2 ? FMath::Clamp(FCString::Atoi(*Args[2]), 8, 1024) : 96;
+        
+        FMinesweeperGame Game;
+        Game.NewGame(Side, Side, Side * Side / 8, 1);
+        const TSharedRef<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> Source = Game.GetReadSnapshotSource();
+        
+        std::atomic<bool> bStop(false);
+        std::atomic<int64> SnapshotsChecked(0);
+        std::atomic<int64> Errors(0);
+        
+        TArray<TFuture<void>> Readers;
+        for (int32 ReaderIndex = 0; ReaderIndex < NumReaders; ++ReaderIndex)
+        {
+            Readers.Add(Async(EAsyncExecution::Thread, [Source, &bStop, &SnapshotsChecked, &Errors]()
+            {
+                uint64 LastVersion = 0;
+                while (!bStop)
+                {
+                    const TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> Snapshot = Source->GetLatest();
+                    
+                    // Versions only ever move forward
+                    Errors += Snapshot->GetStateVersion() < LastVersion;
+                    LastVersion = Snapshot->GetStateVersion();
+                    
+                    Errors += CountReadSnapshotErrors(*Snapshot);
+                    SnapshotsChecked++;
+                }
+            }));
+        }
+        
+        // Every kind of change the game thread publishes, as fast as it can. Mostly safe
+        // reveals, so games last long enough to build up history to undo.
+        FRandomStream RandomStream(1);
+        int32 Changes = 0;
+        const double EndTime = FPlatformTime::Seconds() + Seconds;
+        while (FPlatformTime::Seconds() < EndTime)
+        {
+            if (Game.IsGameOver() || Game.IsGameWon())
+            {
+                Game.NewGame(Side, Side, Side * Side / 8, RandomStream.RandHelper(MAX_int32));
+                Changes++;
+                continue;
+            }
+            
+            const int32 X = RandomStream.RandRange(0, Side - 1);
+            const int32 Y = RandomStream.RandRange(0, Side - 1);
+            const FMinesweeperGame::FTile Tile = Game.GetTile(X, Y);
+            const int32 Roll = RandomStream.RandRange(0, 99);
+            
+            bool bChanged;
+            if (Roll < 10)
+            {
+                bChanged = Game.Undo();
+            }
+            else if (Roll < 15)
+            {
+                bChanged = Game.Redo();
+            }
+            else if (Roll < 35)
+            {
+                bChanged = Game.ChordTile(X, Y);
+            }
+            else if (Tile.bIsBomb && Game.GetMoveCount() > 0 && Roll < 98)
+            {
+                // Only mines are flagged, so no flag ever cuts a flood fill short
+                bChanged = Game.ToggleFlag(X, Y);
+            }
+            else
+            {
+                bChanged = Game.RevealTile(X, Y);
+            }
+            Changes += bChanged;
+        }
+        
+        bStop = true;
+        for (TFuture<void>& Reader : Readers)
+        {
+            Reader.Wait();
+        }
+        
+        UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("%d changes published, %lld snapshots checked by %d readers, %lld errors"),
+            Changes, (long long)SnapshotsChecked.load(), NumReaders, (long long)Errors.load());
+    }));
+
+static FAutoConsoleCommand BatchBenchmarkCommand(
+    TEXT("Minesweeper.Bench.Batch"),
+    TEXT("Play many small boards with random clicks that avoid mines, 64 at a time with FMinesweeperBatchGame and one at a time with FMinesweeperGame, report games per second for both and check they end the same. Usage: Minesweeper.Bench.Batch [Side=9] [Bombs=10] [Batches=200]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 Side = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 2, 64) : 9;
+        const int32 Bombs = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 0, Side * Side - 1) : 10;
+        const int32 NumBatches = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 200;
+        const int32 NumBoards = FMinesweeperBatchGame::NumBoards;
+        const int32 Steps = Side * Side * 8;
+
+        // The same clicks for both engines: step S of board N clicks Clicks[S * NumBoards + N],
+        // skipping mines after the first click so most games run until they are won
+        TArray<int32> Seeds;
+        TArray<int32> StepClicks;
+        TArray<int32> Clicks;
+        Seeds.SetNumUninitialized(NumBoards);
+        Clicks.SetNumUninitialized(Steps * NumBoards);
+        StepClicks.SetNumUninitialized(NumBoards);
+
+        FMinesweeperBatchGame Batch;
+        FMinesweeperGame Game;
+        Game.SetUndoEnabled(false);
+
+        double BatchSeconds = 0.0;
+        double ScalarSeconds = 0.0;
+        int32 BatchWins = 0;
+        int32 ScalarWins = 0;
+        int32 Mismatches = 0;
+        for (int32 BatchIndex = 0; BatchIndex < NumBatches; ++BatchIndex)
+        {
+            FRandomStream RandomStream(BatchIndex);
+            for (int32& Seed : Seeds)
+            {
+                Seed = RandomStream.RandHelper(MAX_int32);
+            }
+            for (int32& Click : Clicks)
+            {
+                Click = RandomStream.RandRange(0, Side * Side - 1);
+            }
+
+            const double BatchStart = FPlatformTime::Seconds();
+            Batch.NewGames(Side, Side, Bombs, Seeds);
+            for (int32 Step = 0; Step < Steps && Batch.GetFinishedMask() != FMinesweeperBatchGame::AllBoards; ++Step)
+            {
+                for (int32 Board = 0; Board < NumBoards; ++Board)
+                {
+                    const int32 Click = Clicks[Step * NumBoards + Board];
+                    StepClicks[Board] = Step > 0 && Batch.IsBomb(Board, Click % Side, Click / Side) ? INDEX_NONE : Click;
+                }
+                Batch.RevealTiles(StepClicks);
+            }
+            BatchSeconds += FPlatformTime::Seconds() - BatchStart;
+
+            const double ScalarStart = FPlatformTime::Seconds();
+            for (int32 Board = 0; Board < NumBoards; ++Board)
+            {
+                Game.NewGame(Side, Side, Bombs, Seeds[Board]);
+                for (int32 Step = 0; Step < Steps && !Game.IsGameOver() && !Game.IsGameWon(); ++Step)
+                {
+                    const int32 Click = Clicks[Step * NumBoards + Board];
+                    if (Step == 0 || !Game.GetTile(Click % Side, Click / Side).bIsBomb)
+                    {
+                        Game.RevealTile(Click % Side, Click / Side);
+                    }
+                }
+                ScalarWins += Game.IsGameWon();
+                Mismatches += Game.IsGameWon() != Batch.IsGameWon(Board) || Game.IsGameOver() != Batch.IsGameOver(Board);
+            }
+            ScalarSeconds += FPlatformTime::Seconds() - ScalarStart;
+            BatchWins += FMath::CountBits(Batch.GetGameWonMask());
+        }
+
+        const int32 NumGames = NumBatches * NumBoards;
+        UE_LOG(LogMinesweeperBenchmarks, Log, TEXT("%d games on %dx%d with %d bombs: batch %.0f games/s, scalar %.0f games/s (%.1fx), %d won"),
+            NumGames, Side, Side, Bombs, NumGames / FMath::Max(BatchSeconds, 1e-9), NumGames / FMath::Max(ScalarSeconds, 1e-9),
+            ScalarSeconds / FMath::Max(BatchSeconds, 1e-9), BatchWins);
+        if (Mismatches != 0 || BatchWins != ScalarWins)
+        {
+            UE_LOG(LogMinesweeperBenchmarks, Error, TEXT("Batch and scalar games disagree on %d of %d boards"), Mismatches, NumGames);
+        }
+    }));
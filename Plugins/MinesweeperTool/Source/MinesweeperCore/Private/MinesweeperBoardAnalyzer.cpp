@@ -0,0 +1,520 @@
+// MinesweeperBoardAnalyzer.cpp
+#include "MinesweeperBoardAnalyzer.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperAnalyzer, Log, All);
+
+namespace MinesweeperBoardAnalyzer
+{
+    // Heap keys for ZiNi: the smallest key is the highest premium, then the lowest tile index.
+    // A chord saves at most the 8 neighbors and the number itself, so premiums stay below 16.
+    constexpr int32 MaxChordPremium = 16;
+
+    uint64 MakeChordKey(int32 Premium, int32 TileIndex)
+    {
+        return (uint64(MaxChordPremium - Premium) << 32) | uint32(TileIndex);
+    }
+
+    int32 GetChordKeyPremium(uint64 Key)
+    {
+        return MaxChordPremium - int32(Key >> 32);
+    }
+
+    template<typename FunctorType>
+    void ForEachNeighbor(int32 Width, int32 Height, int32 TileIndex, FunctorType&& Functor)
+    {
+        const int32 X = TileIndex % Width;
+        const int32 Y = TileIndex / Width;
+
+        for (int32 DY = -1; DY <= 1; ++DY)
+        {
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                const int32 CheckX = X + DX;
+                const int32 CheckY = Y + DY;
+                if ((DX != 0 || DY != 0) && CheckX >= 0 && CheckX < Width && CheckY >= 0 && CheckY < Height)
+                {
+                    Functor(CheckY * Width + CheckX);
+                }
+            }
+        }
+    }
+}
+
+FMinesweeperBoardAnalyzer::FMinesweeperBoardAnalyzer(const FMinesweeperGame& Game)
+    : Width(Game.GetWidth())
+    , Height(Game.GetHeight())
+    , BombCount(Game.GetBombCount())
+    , NumOpenings(0)
+    , NumRevealed(0)
+{
+    const int32 NumTiles = Width * Height;
+    Bombs.SetNumUninitialized(NumTiles);
+    AdjacentBombs.SetNumUninitialized(NumTiles);
+
+    for (int32 Y = 0; Y < Height; ++Y)
+    {
+        for (int32 X = 0; X < Width; ++X)
+        {
+            const FMinesweeperGame::FTile& Tile = Game.GetTile(X, Y);
+            Bombs[Y * Width + X] = Tile.bIsBomb;
+            AdjacentBombs[Y * Width + X] = static_cast<int8>(Tile.AdjacentBombs);
+        }
+    }
+}
+
+FMinesweeperBoardStats FMinesweeperBoardAnalyzer::Analyze(const FMinesweeperGame& Game, int32 FirstClickX, int32 FirstClickY)
+{
+    FMinesweeperBoardStats Stats;
+    Stats.Seed = Game.GetSeed();
+    Stats.Width = Game.GetWidth();
+    Stats.Height = Game.GetHeight();
+    Stats.BombCount = Game.GetBombCount();
+
+    if (!Game.IsValidCoordinate(FirstClickX, FirstClickY))
+    {
+        return Stats;
+    }
+
+    FMinesweeperBoardAnalyzer Analyzer(Game);
+    Analyzer.LabelRegions(Stats);
+    Stats.ZiNi = Analyzer.EstimateZiNi();
+    Stats.SolverGuesses = Analyzer.CountSolverGuesses(FirstClickY * Stats.Width + FirstClickX);
+
+    return Stats;
+}
+
+FMinesweeperBoardStats FMinesweeperBoardAnalyzer::AnalyzeSeed(int32 Width, int32 Height, int32 BombCount, int32 Seed, int32 FirstClickX, int32 FirstClickY)
+{
+    FMinesweeperGame Game;
+    Game.NewGame(Width, Height, BombCount, Seed);
+
+    // The first click places the bombs
+    FirstClickX = FMath::Clamp(FirstClickX, 0, Game.GetWidth() - 1);
+    FirstClickY = FMath::Clamp(FirstClickY, 0, Game.GetHeight() - 1);
+    Game.RevealTile(FirstClickX, FirstClickY);
+
+    return Analyze(Game, FirstClickX, FirstClickY);
+}
+
+void FMinesweeperBoardAnalyzer::AnalyzeSeeds(int32 Width, int32 Height, int32 BombCount, TArrayView<const int32> Seeds, int32 FirstClickX, int32 FirstClickY, TArray<FMinesweeperBoardStats>& OutStats)
+{
+    OutStats.SetNum(Seeds.Num());
+
+    ParallelFor(Seeds.Num(), [&](int32 Index)
+    {
+        OutStats[Index] = AnalyzeSeed(Width, Height, BombCount, Seeds[Index], FirstClickX, FirstClickY);
+    });
+}
+
+FString FMinesweeperBoardAnalyzer::StatsToCSV(TArrayView<const FMinesweeperBoardStats> Stats)
+{
+    FString CSV = TEXT("Seed,Width,Height,Bombs,3BV,Openings,Islands,ZiNi,SolverGuesses\n");
+    CSV.Reserve(CSV.Len() + Stats.Num() * 48);
+
+    for (const FMinesweeperBoardStats& Row : Stats)
+    {
+        CSV += FString::Printf(TEXT("%d,%d,%d,%d,%d,%d,%d,%d,%d\n"),
+            Row.Seed, Row.Width, Row.Height, Row.BombCount,
+            Row.ThreeBV, Row.Openings, Row.Islands, Row.ZiNi, Row.SolverGuesses);
+    }
+
+    return CSV;
+}
+
+void FMinesweeperBoardAnalyzer::LabelRegions(FMinesweeperBoardStats& OutStats)
+{
+    using MinesweeperBoardAnalyzer::ForEachNeighbor;
+
+    const int32 NumTiles = Width * Height;
+    OpeningIds.Init(INDEX_NONE, NumTiles);
+    NeedsClick.Init(false, NumTiles);
+    NumOpenings = 0;
+
+    // Openings: 8-connected regions of empty tiles, each tile visited once
+    for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+    {
+        if (Bombs[TileIndex] || AdjacentBombs[TileIndex] != 0 || OpeningIds[TileIndex] != INDEX_NONE)
+        {
+            continue;
+        }
+
+        OpeningIds[TileIndex] = NumOpenings;
+        Stack.Reset();
+        Stack.Add(TileIndex);
+
+        while (Stack.Num() > 0)
+        {
+            ForEachNeighbor(Width, Height, Stack.Pop(), [this](int32 Neighbor)
+            {
+                if (!Bombs[Neighbor] && AdjacentBombs[Neighbor] == 0 && OpeningIds[Neighbor] == INDEX_NONE)
+                {
+                    OpeningIds[Neighbor] = NumOpenings;
+                    Stack.Add(Neighbor);
+                }
+            });
+        }
+
+        NumOpenings++;
+    }
+
+    // Numbers that no opening touches need a click of their own
+    int32 NumLoneNumbers = 0;
+    for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+    {
+        if (Bombs[TileIndex] || AdjacentBombs[TileIndex] == 0)
+        {
+            continue;
+        }
+
+        bool bTouchesOpening = false;
+        ForEachNeighbor(Width, Height, TileIndex, [this, &bTouchesOpening](int32 Neighbor)
+        {
+            bTouchesOpening |= OpeningIds[Neighbor] != INDEX_NONE;
+        });
+
+        if (!bTouchesOpening)
+        {
+            NeedsClick[TileIndex] = true;
+            NumLoneNumbers++;
+        }
+    }
+
+    // Islands: 8-connected groups of those numbers
+    int32 NumIslands = 0;
+    TArray<bool> Visited;
+    Visited.Init(false, NumTiles);
+    for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+    {
+        if (!NeedsClick[TileIndex] || Visited[TileIndex])
+        {
+            continue;
+        }
+
+        Visited[TileIndex] = true;
+        Stack.Reset();
+        Stack.Add(TileIndex);
+
+        while (Stack.Num() > 0)
+        {
+            ForEachNeighbor(Width, Height, Stack.Pop(), [this, &Visited](int32 Neighbor)
+            {
+                if (NeedsClick[Neighbor] && !Visited[Neighbor])
+                {
+                    Visited[Neighbor] = true;
+                    Stack.Add(Neighbor);
+                }
+            });
+        }
+
+        NumIslands++;
+    }
+
+    OutStats.Openings = NumOpenings;
+    OutStats.Islands = NumIslands;
+    OutStats.ThreeBV = NumOpenings + NumLoneNumbers;
+}
+
+int32 FMinesweeperBoardAnalyzer::EstimateZiNi()
+{
+    using MinesweeperBoardAnalyzer::ForEachNeighbor;
+    using MinesweeperBoardAnalyzer::MakeChordKey;
+    using MinesweeperBoardAnalyzer::GetChordKeyPremium;
+
+    ResetReplay();
+
+    const int32 NumTiles = Width * Height;
+    int32 Clicks = 0;
+
+    // Premiums only change around tiles a chord reveals or flags, so only those are recomputed
+    // between chords instead of rescanning the board
+    ChordPremiums.Init(0, NumTiles);
+    ChordHeap.Reset();
+    for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+    {
+        if (!Bombs[TileIndex] && AdjacentBombs[TileIndex] > 0)
+        {
+            ChordPremiums[TileIndex] = GetChordPremium(TileIndex);
+            if (ChordPremiums[TileIndex] > 0)
+            {
+                ChordHeap.HeapPush(MakeChordKey(ChordPremiums[TileIndex], TileIndex));
+            }
+        }
+    }
+
+    // Repeatedly chord the number that saves the most clicks, the lowest index on a tie, as
+    // long as chording pays off
+    while (ChordHeap.Num() > 0)
+    {
+        uint64 Key;
+        ChordHeap.HeapPop(Key);
+        const int32 BestTile = int32(uint32(Key));
+        if (GetChordKeyPremium(Key) != ChordPremiums[BestTile])
+        {
+            continue;
+        }
+
+        // RevealTile records every tile it opens in ChangedTiles, and the flags go in beside them
+        ChangedTiles.Reset();
+        if (!Revealed[BestTile])
+        {
+            Clicks++;
+            RevealTile(BestTile);
+        }
+
+        ForEachNeighbor(Width, Height, BestTile, [this, &Clicks](int32 Neighbor)
+        {
+            if (Bombs[Neighbor] && !Flagged[Neighbor])
+            {
+                Flagged[Neighbor] = true;
+                ChangedTiles.Add(Neighbor);
+                Clicks++;
+            }
+        });
+
+        Clicks++;
+        ForEachNeighbor(Width, Height, BestTile, [this](int32 Neighbor)
+        {
+            if (!Bombs[Neighbor])
+            {
+                RevealTile(Neighbor);
+            }
+        });
+
+        UpdateChordPremiums(ChangedTiles);
+    }
+
+    // Whatever is left is cleared one click per opening or lone number
+    for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+    {
+        const int32 OpeningId = OpeningIds[TileIndex];
+        if ((OpeningId != INDEX_NONE && !OpeningCleared[OpeningId]) || (NeedsClick[TileIndex] && !Revealed[TileIndex]))
+        {
+            Clicks++;
+            RevealTile(TileIndex);
+        }
+    }
+
+    return Clicks;
+}
+
+int32 FMinesweeperBoardAnalyzer::CountSolverGuesses(int32 FirstClickIndex)
+{
+    ResetReplay();
+    RevealTile(FirstClickIndex);
+
+    FMinesweeperSolver Solver;
+    TArray<int32> SafeTiles;
+    const int32 NumSafeTiles = Width * Height - BombCount;
+    int32 Guesses = 0;
+
+    while (NumRevealed < NumSafeTiles)
+    {
+        if (Solver.Solve(View, SafeTiles))
+        {
+            for (const int32 TileIndex : SafeTiles)
+            {
+                RevealTile(TileIndex);
+            }
+            continue;
+        }
+
+        // Stuck - take the lowest-risk tile. A losing guess is kept as a known mine so
+        // the count still covers the whole board.
+        const int32 GuessIndex = Solver.FindLowestRiskTile(View);
+        if (GuessIndex == INDEX_NONE)
+        {
+            break;
+        }
+
+        Guesses++;
+        if (Bombs[GuessIndex])
+        {
+            View.Tiles[GuessIndex] = FMinesweeperSolver::MineTile;
+        }
+        else
+        {
+            RevealTile(GuessIndex);
+        }
+    }
+
+    return Guesses;
+}
+
+void FMinesweeperBoardAnalyzer::RevealTile(int32 TileIndex)
+{
+    using MinesweeperBoardAnalyzer::ForEachNeighbor;
+
+    if (Revealed[TileIndex] || Bombs[TileIndex])
+    {
+        return;
+    }
+
+    Revealed[TileIndex] = true;
+    View.Tiles[TileIndex] = AdjacentBombs[TileIndex];
+    ChangedTiles.Add(TileIndex);
+    NumRevealed++;
+
+    if (AdjacentBombs[TileIndex] != 0)
+    {
+        return;
+    }
+
+    // Empty tile - reveal its whole opening and the numbers around it
+    OpeningCleared[OpeningIds[TileIndex]] = true;
+    Stack.Reset();
+    Stack.Add(TileIndex);
+
+    while (Stack.Num() > 0)
+    {
+        ForEachNeighbor(Width, Height, Stack.Pop(), [this](int32 Neighbor)
+        {
+            if (!Revealed[Neighbor] && !Bombs[Neighbor])
+            {
+                Revealed[Neighbor] = true;
+                View.Tiles[Neighbor] = AdjacentBombs[Neighbor];
+                ChangedTiles.Add(Neighbor);
+                NumRevealed++;
+
+                if (AdjacentBombs[Neighbor] == 0)
+                {
+                    Stack.Add(Neighbor);
+                }
+            }
+        });
+    }
+}
+
+void FMinesweeperBoardAnalyzer::ResetReplay()
+{
+    const int32 NumTiles = Width * Height;
+    Revealed.Init(false, NumTiles);
+    Flagged.Init(false, NumTiles);
+    OpeningCleared.Init(false, NumOpenings);
+    ChangedTiles.Reset();
+    NumRevealed = 0;
+
+    View.Width = Width;
+    View.Height = Height;
+    View.BombCount = BombCount;
+    View.Tiles.Init(FMinesweeperSolver::HiddenTile, NumTiles);
+}
+
+int32 FMinesweeperBoardAnalyzer::GetChordPremium(int32 TileIndex) const
+{
+    using MinesweeperBoardAnalyzer::ForEachNeighbor;
+
+    // Clicks spent: reveal the number if needed, flag its bombs, then chord
+    int32 Cost = Revealed[TileIndex] ? 1 : 2;
+    int32 Gain = (!Revealed[TileIndex] && NeedsClick[TileIndex]) ? 1 : 0;
+
+    // Clicks saved: every lone number and every distinct opening the chord uncovers
+    int32 SeenOpenings[8];
+    int32 NumSeenOpenings = 0;
+
+    ForEachNeighbor(Width, Height, TileIndex, [&](int32 Neighbor)
+    {
+        if (Bombs[Neighbor])
+        {
+            Cost += Flagged[Neighbor] ? 0 : 1;
+        }
+        else if (!Revealed[Neighbor])
+        {
+            const int32 OpeningId = OpeningIds[Neighbor];
+            if (OpeningId != INDEX_NONE)
+            {
+                bool bSeen = OpeningCleared[OpeningId];
+                for (int32 i = 0; i < NumSeenOpenings; ++i)
+                {
+                    bSeen |= SeenOpenings[i] == OpeningId;
+                }
+
+                if (!bSeen)
+                {
+                    SeenOpenings[NumSeenOpenings++] = OpeningId;
+                    Gain++;
+                }
+            }
+            else if (NeedsClick[Neighbor])
+            {
+                Gain++;
+            }
+        }
+    });
+
+    return Gain - Cost;
+}
+
+void FMinesweeperBoardAnalyzer::UpdateChordPremiums(TArrayView<const int32> Tiles)
+{
+    using MinesweeperBoardAnalyzer::ForEachNeighbor;
+    using MinesweeperBoardAnalyzer::MakeChordKey;
+
+    // A premium reads its own tile and its neighbors, and an opening is only cleared by revealing
+    // all of it, so the tiles around each change are all that can move
+    auto Update = [this](int32 TileIndex)
+    {
+        if (Bombs[TileIndex] || AdjacentBombs[TileIndex] == 0)
+        {
+            return;
+        }
+
+        const int32 Premium = GetChordPremium(TileIndex);
+        if (Premium != ChordPremiums[TileIndex])
+        {
+            ChordPremiums[TileIndex] = Premium;
+            if (Premium > 0)
+            {
+                ChordHeap.HeapPush(MakeChordKey(Premium, TileIndex));
+            }
+        }
+    };
+
+    for (const int32 TileIndex : Tiles)
+    {
+        Update(TileIndex);
+        ForEachNeighbor(Width, Height, TileIndex, Update);
+    }
+}
+
+static FAutoConsoleCommand AnalyzeBoardsCommand(
+    TEXT("Minesweeper.AnalyzeBoards"),
+    TEXT("Grade many seeded boards and write the metrics as CSV. Usage: Minesweeper.AnalyzeBoards <Width> <Height> <Bombs> <NumSeeds> [FirstSeed]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        if (Args.Num() < 4)
+        {
+            UE_LOG(LogMinesweeperAnalyzer, Warning, TEXT("Usage: Minesweeper.AnalyzeBoards <Width> <Height> <Bombs> <NumSeeds> [FirstSeed]"));
+            return;
+        }
+
+        const int32 Width = FCString::Atoi(*Args[0]);
+        const int32 Height = FCString::Atoi(*Args[1]);
+        const int32 BombCount = FCString::Atoi(*Args[2]);
+        const int32 NumSeeds = FMath::Max(1, FCString::Atoi(*Args[3]));
+        const int32 FirstSeed = Args.Num() > 4 ? FCString::Atoi(*Args[4]) : 0;
+
+        TArray<int32> Seeds;
+        Seeds.Reserve(NumSeeds);
+        for (int32 Index = 0; Index < NumSeeds; ++Index)
+        {
+            Seeds.Add(FirstSeed + Index);
+        }
+
+        // Classic first click in the middle of the board
+        TArray<FMinesweeperBoardStats> Stats;
+        FMinesweeperBoardAnalyzer::AnalyzeSeeds(Width, Height, BombCount, Seeds, Width / 2, Height / 2, Stats);
+
+        const FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Minesweeper") / TEXT("BoardAnalysis.csv");
+        if (FFileHelper::SaveStringToFile(FMinesweeperBoardAnalyzer::StatsToCSV(Stats), *OutputPath))
+        {
+            UE_LOG(LogMinesweeperAnalyzer, Log, TEXT("Analyzed %d boards, results written to %s"), Stats.Num(), *OutputPath);
+        }
+        else
+        {
+            UE_LOG(LogMinesweeperAnalyzer, Error, TEXT("Failed to write %s"), *OutputPath);
+        }
+    }));
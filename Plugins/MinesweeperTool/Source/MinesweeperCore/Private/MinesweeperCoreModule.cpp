@@ -0,0 +1,4 @@
+// MinesweeperCoreModule.cpp
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, MinesweeperCore)
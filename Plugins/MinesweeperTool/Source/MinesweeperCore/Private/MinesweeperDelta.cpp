@@ -0,0 +1,389 @@
+// MinesweeperDelta.cpp
+#include "MinesweeperDelta.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperDelta, Log, All);
+
+static_assert(sizeof(FMinesweeperDelta::FHeader) == 48, "The delta header is part of the wire format");
+
+namespace MinesweeperDelta
+{
+    void WriteVarint(TArray<uint8>& Bytes, uint32 Value)
+    {
+        while (Value >= 0x80)
+        {
+            Bytes.Add(uint8(Value | 0x80));
+            Value >>= 7;
+        }
+        Bytes.Add(uint8(Value));
+    }
+
+    bool ReadVarint(TArrayView<const uint8> Bytes, int32& Offset, uint32& OutValue)
+    {
+        OutValue = 0;
+        for (int32 Shift = 0; Shift < 35; Shift += 7)
+        {
+            if (Offset >= Bytes.Num())
+            {
+                return false;
+            }
+
+            const uint8 Byte = Bytes[Offset++];
+            OutValue |= uint32(Byte & 0x7F) << Shift;
+            if ((Byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Collects changed tiles, in increasing index order, into runs. An unchanged gap of up to
+    // BridgeTiles between two changes costs less inside a run than as a new run's header, so
+    // GetCodeAt is asked for the codes of those tiles.
+    class FRunWriter
+    {
+    public:
+        static constexpr int32 BridgeTiles = 4;
+
+        explicit FRunWriter(TArray<uint8>& InBytes)
+            : Bytes(InBytes)
+            , RunStart(INDEX_NONE)
+            , RunEnd(0)
+            , PreviousEnd(0)
+            , NumRuns(0)
+        {
+        }
+
+        template<typename GetCodeType>
+        void AddChanged(int32 Index, uint8 Code, GetCodeType&& GetCodeAt)
+        {
+            if (RunStart != INDEX_NONE && Index - RunEnd <= BridgeTiles)
+            {
+                for (int32 Bridged = RunEnd; Bridged < Index; ++Bridged)
+                {
+                    Codes.Add(GetCodeAt(Bridged));
+                }
+            }
+            else
+            {
+                Flush();
+                RunStart = Index;
+            }
+            Codes.Add(Code);
+            RunEnd = Index + 1;
+        }
+
+        void Flush()
+        {
+            if (RunStart == INDEX_NONE)
+            {
+                return;
+            }
+
+            WriteVarint(Bytes, uint32(RunStart - PreviousEnd));
+            WriteVarint(Bytes, uint32(Codes.Num()));
+            const int32 FirstByte = Bytes.AddZeroed((Codes.Num() + 1) / 2);
+            for (int32 Index = 0; Index < Codes.Num(); ++Index)
+            {
+                Bytes[FirstByte + Index / 2] |= Codes[Index] << ((Index & 1) * 4);
+            }
+
+            NumRuns++;
+            PreviousEnd = RunEnd;
+            RunStart = INDEX_NONE;
+            Codes.Reset();
+        }
+
+        int32 GetNumRuns() const { return NumRuns; }
+
+    private:
+        TArray<uint8>& Bytes;
+        TArray<uint8> Codes;
+        int32 RunStart;
+        int32 RunEnd;
+        int32 PreviousEnd;
+        int32 NumRuns;
+    };
+}
+
+void FMinesweeperDelta::Encode(const FMinesweeperGame* From, const FMinesweeperGame& To, TArray<uint8>& OutMessage)
+{
+    // Read snapshots are never paged, so their chunks can be read directly
+    check(!To.IsPaged() && (!From || !From->IsPaged()));
+
+    const bool bKeyframe = !From || From->Width != To.Width || From->Height != To.Height || From->Layout != To.Layout;
+    const FMinesweeperGame::FChunk* EmptyChunk = FMinesweeperGame::GetEmptyChunk().Get();
+
+    auto GetCode = [](const FMinesweeperGame::FChunk& Chunk, int32 StorageIndex) -> uint8
+    {
+        if (FMinesweeperGame::GetBit(Chunk.ExplodedBits, StorageIndex))
+        {
+            return uint8(ETileCode::Exploded);
+        }
+        if (FMinesweeperGame::GetBit(Chunk.RevealedBits, StorageIndex))
+        {
+            return FMinesweeperGame::GetBit(Chunk.BombBits, StorageIndex)
+                ? uint8(ETileCode::Mine)
+                : uint8(ETileCode::Revealed0) + FMinesweeperGame::GetNibble(Chunk.AdjacentCounts, StorageIndex);
+        }
+        return FMinesweeperGame::GetBit(Chunk.FlaggedBits, StorageIndex) ? uint8(ETileCode::Flagged) : uint8(ETileCode::Hidden);
+    };
+
+    // Tiles of one 64-tile word whose code may differ between two chunks. Only flags and reveals
+    // change within a game; a tile revealed in both can only differ when the board under it is
+    // another game's.
+    auto GetChangedBits = [](const FMinesweeperGame::FChunk& A, const FMinesweeperGame::FChunk& B, int32 Word) -> uint64
+    {
+        uint64 Changed = (A.RevealedBits[Word] ^ B.RevealedBits[Word]) | (A.ExplodedBits[Word] ^ B.ExplodedBits[Word]) | (A.FlaggedBits[Word] ^ B.FlaggedBits[Word]);
+        const uint64 BothRevealed = A.RevealedBits[Word] & B.RevealedBits[Word];
+        if (BothRevealed != 0
+            && (A.BombBits[Word] != B.BombBits[Word] || FMemory::Memcmp(A.AdjacentCounts + Word * 32, B.AdjacentCounts + Word * 32, 32) != 0))
+        {
+            Changed |= BothRevealed;
+        }
+        return Changed;
+    };
+
+    auto GetCodeAt = [&To, &GetCode](int32 TileIndex)
+    {
+        const int32 StorageIndex = To.GetStorageIndex(TileIndex % To.Width, TileIndex / To.Width);
+        return GetCode(*To.Chunks[StorageIndex >> FMinesweeperGame::ChunkShift], StorageIndex);
+    };
+
+    const int32 HeaderOffset = OutMessage.AddZeroed(sizeof(FHeader));
+    MinesweeperDelta::FRunWriter Runs(OutMessage);
+
+    // Walk the board row by row in stretches that lie in one chunk, where storage indices are
+    // consecutive. A chunk both snapshots share has not changed, so its stretches are skipped,
+    // and within the others only the tiles in changed words are decoded.
+    for (int32 Y = 0; Y < To.Height; ++Y)
+    {
+        for (int32 X = 0; X < To.Width;)
+        {
+            const int32 StorageIndex = To.GetStorageIndex(X, Y);
+            const int32 ChunkIndex = StorageIndex >> FMinesweeperGame::ChunkShift;
+            const int32 StretchLength = To.Layout == FMinesweeperGame::EBoardLayout::RowMajor
+                ? FMath::Min(To.Width - X, FMinesweeperGame::ChunkTiles - (StorageIndex & (FMinesweeperGame::ChunkTiles - 1)))
+                : FMath::Min(To.Width - X, FMinesweeperGame::TileSide - (X & (FMinesweeperGame::TileSide - 1)));
+
+            const FMinesweeperGame::FChunk* ToChunk = To.Chunks[ChunkIndex].Get();
+            const FMinesweeperGame::FChunk* FromChunk = bKeyframe ? EmptyChunk : From->Chunks[ChunkIndex].Get();
+            for (int32 Offset = 0; ToChunk != FromChunk && Offset < StretchLength;)
+            {
+                const int32 WordIndex = StorageIndex + Offset;
+                const int32 Bit = WordIndex & 63;
+                const int32 NumInWord = FMath::Min(64 - Bit, StretchLength - Offset);
+                uint64 Changed = GetChangedBits(*FromChunk, *ToChunk, (WordIndex >> 6) & (FMinesweeperGame::ChunkWords - 1)) >> Bit;
+                Changed &= NumInWord < 64 ? (1ull << NumInWord) - 1 : ~0ull;
+
+                while (Changed != 0)
+                {
+                    const int32 TileOffset = Offset + int32(FMath::CountTrailingZeros64(Changed));
+                    Changed &= Changed - 1;
+
+                    const uint8 Code = GetCode(*ToChunk, StorageIndex + TileOffset);
+                    if (Code != GetCode(*FromChunk, StorageIndex + TileOffset))
+                    {
+                        Runs.AddChanged(Y * To.Width + X + TileOffset, Code, GetCodeAt);
+                    }
+                }
+                Offset += NumInWord;
+            }
+            X += StretchLength;
+        }
+    }
+    Runs.Flush();
+
+    FHeader Header;
+    FMemory::Memzero(&Header, sizeof(Header));
+    Header.Magic = Magic;
+    Header.Size = uint32(OutMessage.Num() - HeaderOffset);
+    Header.FromVersion = bKeyframe ? 0 : From->GetStateVersion();
+    Header.ToVersion = To.GetStateVersion();
+    Header.Width = To.Width;
+    Header.Height = To.Height;
+    Header.RemainingMines = To.GetRemainingMines();
+    Header.NumRuns = Runs.GetNumRuns();
+    Header.Version = CurrentVersion;
+    Header.Flags = bKeyframe ? Keyframe : 0;
+    Header.GameState = To.IsGameOver() ? EGameState::Lost : (To.IsGameWon() ? EGameState::Won : EGameState::Playing);
+    FMemory::Memcpy(OutMessage.GetData() + HeaderOffset, &Header, sizeof(Header));
+}
+
+bool FMinesweeperDelta::ReadHeader(TArrayView<const uint8> Data, FHeader& OutHeader)
+{
+    if (Data.Num() < int32(sizeof(FHeader)))
+    {
+        return false;
+    }
+    FMemory::Memcpy(&OutHeader, Data.GetData(), sizeof(FHeader));
+
+    return OutHeader.Magic == Magic
+        && OutHeader.Version == CurrentVersion
+        && OutHeader.Size >= sizeof(FHeader) && OutHeader.Size <= uint32(MAX_int32)
+        && OutHeader.Width >= 1 && OutHeader.Height >= 1 && int64(OutHeader.Width) * OutHeader.Height <= MAX_int32
+        && OutHeader.NumRuns >= 0
+        && (OutHeader.Flags & ~Keyframe) == 0
+        && OutHeader.GameState <= EGameState::Won;
+}
+
+bool FMinesweeperDelta::Apply(TArrayView<const uint8> Message, TArray<uint8>& InOutTileCodes, FHeader& OutHeader)
+{
+    if (!ReadHeader(Message, OutHeader) || OutHeader.Size != uint32(Message.Num()))
+    {
+        return false;
+    }
+
+    const int32 NumTiles = OutHeader.Width * OutHeader.Height;
+    if (OutHeader.Flags & Keyframe)
+    {
+        InOutTileCodes.Init(uint8(ETileCode::Hidden), NumTiles);
+    }
+    else if (InOutTileCodes.Num() != NumTiles)
+    {
+        return false;
+    }
+
+    // A message that turns out malformed part way leaves the board partly updated; the viewer
+    // has to start over from a keyframe
+    int32 Offset = sizeof(FHeader);
+    int64 TileIndex = 0;
+    for (int32 Run = 0; Run < OutHeader.NumRuns; ++Run)
+    {
+        uint32 Gap, Length;
+        if (!MinesweeperDelta::ReadVarint(Message, Offset, Gap) || !MinesweeperDelta::ReadVarint(Message, Offset, Length))
+        {
+            return false;
+        }
+
+        TileIndex += Gap;
+        const int32 NumBytes = int32((int64(Length) + 1) / 2);
+        if (TileIndex + Length > NumTiles || NumBytes > Message.Num() - Offset)
+        {
+            return false;
+        }
+
+        uint8* Codes = InOutTileCodes.GetData() + TileIndex;
+        const uint8* Packed = Message.GetData() + Offset;
+        for (uint32 Index = 0; Index < Length; ++Index)
+        {
+            Codes[Index] = (Packed[Index / 2] >> ((Index & 1) * 4)) & 0xF;
+        }
+
+        TileIndex += Length;
+        Offset += NumBytes;
+    }
+
+    return Offset == Message.Num();
+}
+
+FMinesweeperDelta::ETileCode FMinesweeperDelta::GetTileCode(const FMinesweeperGame::FTile& Tile)
+{
+    switch (Tile.State)
+    {
+        case FMinesweeperGame::ETileState::Exploded:
+            return ETileCode::Exploded;
+        case FMinesweeperGame::ETileState::Revealed:
+            return Tile.bIsBomb ? ETileCode::Mine : ETileCode(uint8(ETileCode::Revealed0) + Tile.AdjacentBombs);
+        default:
+            return Tile.bIsFlagged ? ETileCode::Flagged : ETileCode::Hidden;
+    }
+}
+
+static FAutoConsoleCommand DeltaBenchmarkCommand(
+    TEXT("Minesweeper.Bench.Delta"),
+    TEXT("Play random moves on a large board and mirror it through deltas, for a viewer that takes every state and one that only keeps up with every Nth. Checks both mirrors at the end. Usage: Minesweeper.Bench.Delta [Side=4096] [Moves=300] [SlowEvery=8]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 Side = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 16, 8192) : 4096;
+        const int32 Moves = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 300;
+        const int32 SlowEvery = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 8;
+
+        for (const FMinesweeperGame::EBoardLayout Layout : { FMinesweeperGame::EBoardLayout::RowMajor, FMinesweeperGame::EBoardLayout::Tiled })
+        {
+            FMinesweeperGame Game;
+            const TSharedRef<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> Source = Game.GetReadSnapshotSource();
+            FRandomStream Random(Side);
+
+            // A viewer: its mirror, the snapshot it is at, and what it took to keep it there
+            struct FViewer
+            {
+                TArray<uint8> TileCodes;
+                TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> Snapshot;
+                TArray<uint8> Message;
+                int64 Bytes = 0;
+                int32 Messages = 0;
+                int32 Failures = 0;
+                double EncodeSeconds = 0.0;
+                double ApplySeconds = 0.0;
+            };
+            FViewer Viewers[2];
+
+            auto CatchUp = [&Source](FViewer& Viewer)
+            {
+                const TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> Latest = Source->GetLatest();
+                const double EncodeStart = FPlatformTime::Seconds();
+                Viewer.Message.Reset();
+                FMinesweeperDelta::Encode(Viewer.Snapshot.Get(), *Latest, Viewer.Message);
+                const double ApplyStart = FPlatformTime::Seconds();
+                FMinesweeperDelta::FHeader Header;
+                Viewer.Failures += !FMinesweeperDelta::Apply(Viewer.Message, Viewer.TileCodes, Header);
+                const double ApplyEnd = FPlatformTime::Seconds();
+
+                Viewer.EncodeSeconds += ApplyStart - EncodeStart;
+                Viewer.ApplySeconds += ApplyEnd - ApplyStart;
+                Viewer.Bytes += Viewer.Message.Num();
+                Viewer.Messages++;
+                Viewer.Snapshot = Latest;
+            };
+
+            Game.NewGame(Side, Side, Side * Side / 8, Side, Layout);
+            for (int32 Move = 0; Move < Moves; ++Move)
+            {
+                if (Game.IsGameOver() || Game.IsGameWon())
+                {
+                    Game.NewGame(Side, Side, Side * Side / 8, Random.GetUnsignedInt(), Layout);
+                }
+                else
+                {
+                    const int32 X = Random.RandHelper(Side);
+                    const int32 Y = Random.RandHelper(Side);
+                    if (Random.FRand() < 0.2f)
+                    {
+                        Game.ToggleFlag(X, Y);
+                    }
+                    else
+                    {
+                        Game.RevealTile(X, Y);
+                    }
+                }
+
+                CatchUp(Viewers[0]);
+                if (Move % SlowEvery == SlowEvery - 1 || Move == Moves - 1)
+                {
+                    CatchUp(Viewers[1]);
+                }
+            }
+
+            UE_LOG(LogMinesweeperDelta, Log, TEXT("%s %dx%d board, %d moves:"), Layout == FMinesweeperGame::EBoardLayout::Tiled ? TEXT("Tiled") : TEXT("RowMajor"), Side, Side, Moves);
+            for (int32 ViewerIndex = 0; ViewerIndex < int32(UE_ARRAY_COUNT(Viewers)); ++ViewerIndex)
+            {
+                FViewer& Viewer = Viewers[ViewerIndex];
+                int32 Mismatches = 0;
+                for (int32 Y = 0; Y < Side; ++Y)
+                {
+                    for (int32 X = 0; X < Side; ++X)
+                    {
+                        Mismatches += Viewer.TileCodes[Y * Side + X] != uint8(FMinesweeperDelta::GetTileCode(Game.GetTile(X, Y)));
+                    }
+                }
+
+                UE_LOG(LogMinesweeperDelta, Log, TEXT("  %s viewer: %d messages, %.2f MB (%.1f KB each), encode %.2f ms and apply %.2f ms per message, %d rejected, %d tiles differ"),
+                    ViewerIndex == 0 ? TEXT("Every-state") : TEXT("Slow"), Viewer.Messages, Viewer.Bytes / (1024.0 * 1024.0), Viewer.Bytes / 1024.0 / Viewer.Messages,
+                    Viewer.EncodeSeconds * 1000.0 / Viewer.Messages, Viewer.ApplySeconds * 1000.0 / Viewer.Messages, Viewer.Failures, Mismatches);
+            }
+        }
+    }));
@@ -0,0 +1,1036 @@
+// MinesweeperGame.cpp
+#include "MinesweeperGame.h"
+#include "Math/UnrealMathUtility.h"
+#include "Math/RandomStream.h"
+#include "MinesweeperStats.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperGame, Log, All);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Chunk Cache Hit Rate"), STAT_MinesweeperChunkHitRate, STATGROUP_Minesweeper);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Chunk Page-Ins"), STAT_MinesweeperChunkPageIns, STATGROUP_Minesweeper);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Chunk Page-Outs"), STAT_MinesweeperChunkPageOuts, STATGROUP_Minesweeper);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Resident Chunks"), STAT_MinesweeperResidentChunks, STATGROUP_Minesweeper);
+
+struct FMinesweeperGame::FPagingState
+{
+    enum EChunkFlags : uint8
+    {
+        Resident = 1 << 0,
+        Dirty = 1 << 1,
+        OnDisk = 1 << 2
+    };
+
+    ~FPagingState()
+    {
+        File.Reset();
+        FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*Filename);
+    }
+
+    // Unlink a chunk from the LRU list
+    void Unlink(int32 ChunkIndex)
+    {
+        const int32 Newer = NewerChunk[ChunkIndex];
+        const int32 Older = OlderChunk[ChunkIndex];
+        (Newer != INDEX_NONE ? OlderChunk[Newer] : Newest) = Older;
+        (Older != INDEX_NONE ? NewerChunk[Older] : Oldest) = Newer;
+    }
+
+    // Put a chunk at the most recently used end of the LRU list
+    void PushNewest(int32 ChunkIndex)
+    {
+        NewerChunk[ChunkIndex] = INDEX_NONE;
+        OlderChunk[ChunkIndex] = Newest;
+        (Newest != INDEX_NONE ? NewerChunk[Newest] : Oldest) = ChunkIndex;
+        Newest = ChunkIndex;
+    }
+
+    FString Filename;
+    TUniquePtr<IFileHandle> File;
+
+    TArray<uint8> Flags;
+    TArray<int32> NewerChunk;
+    TArray<int32> OlderChunk;
+    int32 Newest = INDEX_NONE;
+    int32 Oldest = INDEX_NONE;
+
+    FPagingStats Stats;
+};
+
+FMinesweeperGame::FMinesweeperGame()
+    : Layout(EBoardLayout::RowMajor)
+    , ChunksPerRow(0)
+    , StateVersion(0)
+    , ChangeId(0)
+    , bRecordingChange(false)
+    , bUndoEnabled(true)
+    , Width(0)
+    , Height(0)
+    , BombCount(0)
+    , Seed(0)
+    , bGameOver(false)
+    , bGameWon(false)
+    , RevealedTiles(0)
+    , MoveCount(0)
+    , FlagCount(0)
+{
+}
+
+FMinesweeperGame::FMinesweeperGame(FMinesweeperGame&&) = default;
+FMinesweeperGame& FMinesweeperGame::operator=(FMinesweeperGame&&) = default;
+FMinesweeperGame::~FMinesweeperGame() = default;
+
+void FMinesweeperGame::NewGame(int32 InWidth, int32 InHeight, int32 InBombCount)
+{
+    NewGame(InWidth, InHeight, InBombCount, FMath::Rand());
+}
+
+void FMinesweeperGame::NewGame(int32 InWidth, int32 InHeight, int32 InBombCount, int32 InSeed, EBoardLayout InLayout)
+{
+    StartNewGame(InWidth, InHeight, InBombCount, InSeed, InLayout);
+    
+    // Initialize grid; every chunk starts as the shared empty chunk
+    ResetChunks();
+    
+    // Don't place bombs yet - we'll do that on first click to ensure
+    // the first click is never a bomb
+    PublishReadSnapshot();
+}
+
+void FMinesweeperGame::NewPagedGame(int32 InWidth, int32 InHeight, int32 InBombCount, int32 InSeed, int64 MemoryCapBytes, const FString& PageFilename)
+{
+    // Square chunks keep a flood fill inside a handful of resident chunks
+    StartNewGame(InWidth, InHeight, InBombCount, InSeed, EBoardLayout::Tiled);
+    ResetChunks();
+    
+    Paging = MakeUnique<FPagingState>();
+    Paging->Filename = PageFilename.IsEmpty()
+        ? FPaths::CreateTempFilename(*(FPaths::ProjectSavedDir() / TEXT("Minesweeper")), TEXT("Board"), TEXT(".pages"))
+        : PageFilename;
+    
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Paging->Filename));
+    Paging->File.Reset(PlatformFile.OpenWrite(*Paging->Filename, false, true));
+    if (!Paging->File)
+    {
+        UE_LOG(LogMinesweeperGame, Error, TEXT("Could not open page file %s, keeping the board in memory"), *Paging->Filename);
+        Paging.Reset();
+        PublishReadSnapshot();
+        return;
+    }
+    
+    // Nothing is loaded yet; a chunk that was never written pages in as the empty chunk
+    const int32 NumChunks = Chunks.Num();
+    for (FChunkPtr& Chunk : Chunks)
+    {
+        Chunk.Reset();
+    }
+    Paging->Flags.Init(0, NumChunks);
+    Paging->NewerChunk.Init(INDEX_NONE, NumChunks);
+    Paging->OlderChunk.Init(INDEX_NONE, NumChunks);
+    
+    // A few chunks around the one being written must always fit
+    Paging->Stats.MaxResidentChunks = int32(FMath::Clamp<int64>(MemoryCapBytes / int64(sizeof(FChunk)), 64, NumChunks));
+    PublishReadSnapshot();
+}
+
+FMinesweeperGame::FPagingStats FMinesweeperGame::GetPagingStats() const
+{
+    return Paging.IsValid() ? Paging->Stats : FPagingStats();
+}
+
+void FMinesweeperGame::StartNewGame(int32 InWidth, int32 InHeight, int32 InBombCount, int32 InSeed, EBoardLayout InLayout)
+{
+    // Validate input parameters
+    Width = FMath::Max(1, InWidth);
+    Height = FMath::Max(1, InHeight);
+    
+    // Ensure there's at least one safe tile
+    const int32 MaxBombs = (Width * Height) - 1;
+    BombCount = FMath::Clamp(InBombCount, 0, MaxBombs);
+    Seed = InSeed;
+    
+    // Reset game state
+    bGameOver = false;
+    bGameWon = false;
+    RevealedTiles = 0;
+    MoveCount = 0;
+    FlagCount = 0;
+    Layout = InLayout;
+}
+
+bool FMinesweeperGame::RevealTile(int32 X, int32 Y, TArray<int32>* OutRevealedTiles)
+{
+    const FAction Action{ EActionType::Reveal, X, Y };
+    return ApplyActions(MakeArrayView(&Action, 1), OutRevealedTiles) > 0;
+}
+
+bool FMinesweeperGame::ChordTile(int32 X, int32 Y, TArray<int32>* OutRevealedTiles)
+{
+    const FAction Action{ EActionType::Chord, X, Y };
+    return ApplyActions(MakeArrayView(&Action, 1), OutRevealedTiles) > 0;
+}
+
+bool FMinesweeperGame::ToggleFlag(int32 X, int32 Y)
+{
+    const FAction Action{ EActionType::Flag, X, Y };
+    return ApplyActions(MakeArrayView(&Action, 1)) > 0;
+}
+
+int32 FMinesweeperGame::ApplyActions(TArrayView<const FAction> Actions, TArray<int32>* OutRevealedTiles, TArray<int32>* OutFlaggedTiles)
+{
+    if (bGameOver || bGameWon)
+    {
+        return 0;
+    }
+    
+    // Validate the whole batch before touching the board
+    for (const FAction& Action : Actions)
+    {
+        if (!IsValidCoordinate(Action.X, Action.Y))
+        {
+            return 0;
+        }
+    }
+    
+    int32 NumApplied = 0;
+    Scratch.FloodQueue.Reset();
+    
+    for (const FAction& Action : Actions)
+    {
+        // Every action sees the board as the reveals before it left it, so a reveal of a tile an
+        // earlier opening already took is not counted. The revealed plane keeps the floods from
+        // checking any tile twice, so running them separately costs no more than one pass.
+        if (Scratch.FloodQueue.Num() > 0)
+        {
+            FloodFillReveal(OutRevealedTiles);
+        }
+        
+        if (!CanApplyAction(Action))
+        {
+            continue;
+        }
+        
+        // Only a batch that changes something becomes a move
+        if (NumApplied++ == 0)
+        {
+            BeginChange();
+        }
+        
+        switch (Action.Type)
+        {
+            case EActionType::Reveal:
+                RevealAt(Action.X, Action.Y, OutRevealedTiles);
+                MoveCount++;
+                break;
+            case EActionType::Flag:
+                ToggleFlagAt(Action.X, Action.Y);
+                if (OutFlaggedTiles)
+                {
+                    OutFlaggedTiles->Add(Action.Y * Width + Action.X);
+                }
+                break;
+            case EActionType::Chord:
+                ChordAt(Action.X, Action.Y, OutRevealedTiles);
+                MoveCount++;
+                break;
+        }
+        
+        if (bGameOver)
+        {
+            break;
+        }
+    }
+    
+    if (NumApplied == 0)
+    {
+        return 0;
+    }
+    
+    // Openings from reveals before a losing click still count
+    FloodFillReveal(OutRevealedTiles);
+    
+    if (bGameOver)
+    {
+        RevealAllBombs(OutRevealedTiles);
+    }
+    else
+    {
+        CheckGameWon();
+    }
+    
+    EndChange();
+    PublishReadSnapshot();
+    
+    if (Paging.IsValid())
+    {
+        PublishPagingStats();
+    }
+    
+    return NumApplied;
+}
+
+bool FMinesweeperGame::CanApplyAction(const FAction& Action) const
+{
+    const int32 TileIndex = GetStorageIndex(Action.X, Action.Y);
+    const FChunk& TileChunk = GetChunk(TileIndex);
+    
+    switch (Action.Type)
+    {
+        case EActionType::Reveal:
+            // Revealed and flagged tiles are left alone
+            return !GetBit(TileChunk.RevealedBits, TileIndex) && !GetBit(TileChunk.ExplodedBits, TileIndex) && !GetBit(TileChunk.FlaggedBits, TileIndex);
+        
+        case EActionType::Flag:
+            return !GetBit(TileChunk.RevealedBits, TileIndex);
+        
+        case EActionType::Chord:
+        {
+            // Only a revealed number with exactly as many flags around it, and something left to reveal
+            const int32 AdjacentBombs = GetNibble(TileChunk.AdjacentCounts, TileIndex);
+            if (!GetBit(TileChunk.RevealedBits, TileIndex) || AdjacentBombs == 0 || GetNibble(TileChunk.FlaggedCounts, TileIndex) != AdjacentBombs)
+            {
+                return false;
+            }
+            
+            for (int32 DY = -1; DY <= 1; ++DY)
+            {
+                for (int32 DX = -1; DX <= 1; ++DX)
+                {
+                    if ((DX != 0 || DY != 0) && IsValidCoordinate(Action.X + DX, Action.Y + DY)
+                        && CanApplyAction(FAction{ EActionType::Reveal, Action.X + DX, Action.Y + DY }))
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+    }
+    
+    return false;
+}
+
+void FMinesweeperGame::RevealAt(int32 X, int32 Y, TArray<int32>* OutRevealedTiles)
+{
+    const int32 TileIndex = GetStorageIndex(X, Y);
+    
+    // First click - initialize bombs ensuring this tile is safe
+    if (RevealedTiles == 0)
+    {
+        if (Paging.IsValid())
+        {
+            PlaceBombsStreaming(X, Y);
+        }
+        else
+        {
+            PlaceBombsRandomly(X, Y);
+        }
+        CalculateAdjacentBombs();
+    }
+    
+    if (OutRevealedTiles)
+    {
+        OutRevealedTiles->Add(Y * Width + X);
+    }
+    
+    // Reveal the tile
+    if (GetBit(GetChunk(TileIndex).BombBits, TileIndex))
+    {
+        // Game over
+        SetBit(GetMutableChunk(TileIndex).ExplodedBits, TileIndex);
+        bGameOver = true;
+    }
+    else
+    {
+        // Reveal this tile
+        SetBit(GetMutableChunk(TileIndex).RevealedBits, TileIndex);
+        RevealedTiles++;
+        
+        // If this is an empty tile, reveal surrounding tiles in the next flood fill
+        if (GetAdjacentCount(TileIndex) == 0)
+        {
+            Scratch.FloodQueue.Add(TPair<int32, int32>(X, Y));
+        }
+    }
+}
+
+void FMinesweeperGame::ChordAt(int32 X, int32 Y, TArray<int32>* OutRevealedTiles)
+{
+    // Reveal every hidden, unflagged neighbor; the empty ones all seed the same flood fill
+    for (int32 DY = -1; DY <= 1; ++DY)
+    {
+        for (int32 DX = -1; DX <= 1; ++DX)
+        {
+            const int32 NeighborX = X + DX;
+            const int32 NeighborY = Y + DY;
+            if ((DX != 0 || DY != 0) && IsValidCoordinate(NeighborX, NeighborY)
+                && CanApplyAction(FAction{ EActionType::Reveal, NeighborX, NeighborY }))
+            {
+                // A wrongly placed flag leaves a bomb among them, which ends the game
+                RevealAt(NeighborX, NeighborY, OutRevealedTiles);
+            }
+        }
+    }
+}
+
+void FMinesweeperGame::RevealAllBombs(TArray<int32>* OutRevealedTiles)
+{
+    // A word at a time, copying only chunks that have hidden bombs
+    for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+    {
+        const FChunk& Chunk = GetChunk(ChunkIndex << ChunkShift);
+        uint64 HiddenBombs = 0;
+        for (int32 Word = 0; Word < ChunkWords; ++Word)
+        {
+            HiddenBombs |= Chunk.BombBits[Word] & ~Chunk.RevealedBits[Word] & ~Chunk.ExplodedBits[Word];
+        }
+        
+        if (HiddenBombs == 0)
+        {
+            continue;
+        }
+        
+        FChunk& MutableChunk = GetMutableChunk(ChunkIndex << ChunkShift);
+        for (int32 Word = 0; Word < ChunkWords; ++Word)
+        {
+            uint64 NewlyRevealed = MutableChunk.BombBits[Word] & ~MutableChunk.RevealedBits[Word] & ~MutableChunk.ExplodedBits[Word];
+            MutableChunk.RevealedBits[Word] |= NewlyRevealed;
+            
+            for (; OutRevealedTiles && NewlyRevealed != 0; NewlyRevealed &= NewlyRevealed - 1)
+            {
+                int32 BombX, BombY;
+                GetTileCoordinates((ChunkIndex << ChunkShift) + Word * 64 + FMath::CountTrailingZeros64(NewlyRevealed), BombX, BombY);
+                OutRevealedTiles->Add(BombY * Width + BombX);
+            }
+        }
+    }
+}
+
+bool FMinesweeperGame::Undo()
+{
+    if (UndoHistory.Num() == 0)
+    {
+        return false;
+    }
+    
+    FHistoryEntry Entry = UndoHistory.Pop(false);
+    SwapHistory(Entry);
+    RedoHistory.Add(MoveTemp(Entry));
+    PublishReadSnapshot();
+    
+    return true;
+}
+
+bool FMinesweeperGame::Redo()
+{
+    if (RedoHistory.Num() == 0)
+    {
+        return false;
+    }
+    
+    FHistoryEntry Entry = RedoHistory.Pop(false);
+    SwapHistory(Entry);
+    UndoHistory.Add(MoveTemp(Entry));
+    PublishReadSnapshot();
+    
+    return true;
+}
+
+int64 FMinesweeperGame::GetBoardAllocatedSize() const
+{
+    int64 Size = Chunks.GetAllocatedSize() + ChunkChangeIds.GetAllocatedSize();
+    for (const FChunkPtr& Chunk : Chunks)
+    {
+        Size += Chunk.IsValid() && Chunk != GetEmptyChunk() ? sizeof(FChunk) : 0;
+    }
+    
+    if (Paging.IsValid())
+    {
+        Size += Paging->Flags.GetAllocatedSize() + Paging->NewerChunk.GetAllocatedSize() + Paging->OlderChunk.GetAllocatedSize();
+    }
+    return Size;
+}
+
+int64 FMinesweeperGame::GetScratchAllocatedSize() const
+{
+    return Scratch.FloodQueue.GetAllocatedSize() + Scratch.TileIndices.GetAllocatedSize() + Scratch.BombIndices.GetAllocatedSize()
+        + Scratch.SpareChunks.GetAllocatedSize() + int64(Scratch.SpareChunks.Num()) * sizeof(FChunk);
+}
+
+int64 FMinesweeperGame::GetHistoryAllocatedSize() const
+{
+    int64 Size = UndoHistory.GetAllocatedSize() + RedoHistory.GetAllocatedSize();
+    for (const TArray<FHistoryEntry>* History : { &UndoHistory, &RedoHistory })
+    {
+        for (const FHistoryEntry& Entry : *History)
+        {
+            Size += Entry.Chunks.GetAllocatedSize();
+            for (const TPair<int32, FChunkPtr>& Chunk : Entry.Chunks)
+            {
+                Size += Chunk.Value != GetEmptyChunk() ? sizeof(FChunk) : 0;
+            }
+        }
+    }
+    return Size;
+}
+
+bool FMinesweeperGame::IsValidCoordinate(int32 X, int32 Y) const
+{
+    return X >= 0 && X < Width && Y >= 0 && Y < Height;
+}
+
+FMinesweeperGame::FTile FMinesweeperGame::GetTile(int32 X, int32 Y) const
+{
+    FTile Tile;
+    if (IsValidCoordinate(X, Y))
+    {
+        const int32 TileIndex = GetStorageIndex(X, Y);
+        const FChunk& Chunk = GetChunk(TileIndex);
+        Tile.bIsBomb = GetBit(Chunk.BombBits, TileIndex);
+        Tile.AdjacentBombs = GetAdjacentCount(TileIndex);
+        Tile.bIsFlagged = GetBit(Chunk.FlaggedBits, TileIndex);
+        Tile.FlaggedNeighbors = GetNibble(Chunk.FlaggedCounts, TileIndex);
+        
+        if (GetBit(Chunk.ExplodedBits, TileIndex))
+        {
+            Tile.State = ETileState::Exploded;
+        }
+        else if (GetBit(Chunk.RevealedBits, TileIndex))
+        {
+            Tile.State = ETileState::Revealed;
+        }
+    }
+    
+    return Tile;
+}
+
+void FMinesweeperGame::ToggleFlagAt(int32 X, int32 Y)
+{
+    const int32 TileIndex = GetStorageIndex(X, Y);
+    FChunk& Chunk = GetMutableChunk(TileIndex);
+    ToggleBit(Chunk.FlaggedBits, TileIndex);
+    const bool bFlagged = GetBit(Chunk.FlaggedBits, TileIndex);
+    FlagCount += bFlagged ? 1 : -1;
+    
+    // Each neighbor's count changes by one; the nibble cannot carry since it stays within 0-8
+    for (int32 DY = -1; DY <= 1; ++DY)
+    {
+        for (int32 DX = -1; DX <= 1; ++DX)
+        {
+            if ((DX != 0 || DY != 0) && IsValidCoordinate(X + DX, Y + DY))
+            {
+                const int32 NeighborIndex = GetStorageIndex(X + DX, Y + DY);
+                uint8& Counts = GetMutableChunk(NeighborIndex).FlaggedCounts[(NeighborIndex & (ChunkTiles - 1)) >> 1];
+                const int32 Delta = 1 << ((NeighborIndex & 1) * 4);
+                Counts = uint8(bFlagged ? Counts + Delta : Counts - Delta);
+            }
+        }
+    }
+}
+
+void FMinesweeperGame::PlaceBombsRandomly(int32 SafeX, int32 SafeY)
+{
+    GenerateBombIndices(Width, Height, BombCount, SafeY * Width + SafeX, Seed, Scratch.BombIndices, Scratch.TileIndices);
+    
+    for (const int32 BombIndex : Scratch.BombIndices)
+    {
+        const int32 TileIndex = GetStorageIndex(BombIndex % Width, BombIndex / Width);
+        SetBit(GetMutableChunk(TileIndex).BombBits, TileIndex);
+    }
+}
+
+void FMinesweeperGame::PlaceBombsStreaming(int32 SafeX, int32 SafeY)
+{
+    // Selection sampling: visit every tile once in storage order and take it with
+    // probability bombs still needed / tiles still left, which gives exactly BombCount
+    // uniformly placed bombs without holding a list of every tile
+    FRandomStream RandomStream(Seed);
+    const int32 SafeIndex = GetStorageIndex(SafeX, SafeY);
+    uint64 TilesLeft = uint64(Width) * uint64(Height) - 1;
+    uint64 BombsLeft = uint64(BombCount);
+    
+    for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num() && BombsLeft > 0; ++ChunkIndex)
+    {
+        FChunk* Chunk = nullptr;
+        for (int32 TileIndex = ChunkIndex << ChunkShift; TileIndex < (ChunkIndex + 1) << ChunkShift && BombsLeft > 0; ++TileIndex)
+        {
+            int32 X, Y;
+            GetTileCoordinates(TileIndex, X, Y);
+            if (!IsValidCoordinate(X, Y) || TileIndex == SafeIndex)
+            {
+                continue;
+            }
+            
+            const uint64 Random = (uint64(RandomStream.GetUnsignedInt()) << 32) | RandomStream.GetUnsignedInt();
+            if (Random % TilesLeft < BombsLeft)
+            {
+                Chunk = Chunk ? Chunk : &GetMutableChunk(TileIndex);
+                SetBit(Chunk->BombBits, TileIndex);
+                BombsLeft--;
+            }
+            TilesLeft--;
+        }
+    }
+}
+
+void FMinesweeperGame::GenerateBombIndices(int32 InWidth, int32 InHeight, int32 InBombCount, int32 SafeIndex, int32 InSeed, TArray<int32>& OutBombIndices)
+{
+    TArray<int32> ValidTileIndices;
+    GenerateBombIndices(InWidth, InHeight, InBombCount, SafeIndex, InSeed, OutBombIndices, ValidTileIndices);
+}
+
+void FMinesweeperGame::GenerateBombIndices(int32 InWidth, int32 InHeight, int32 InBombCount, int32 SafeIndex, int32 InSeed, TArray<int32>& OutBombIndices, TArray<int32>& ValidTileIndices)
+{
+    const int32 NumTiles = InWidth * InHeight;
+    
+    // Create a list of valid tile indices (all tiles except the first click)
+    ValidTileIndices.Reset(NumTiles - 1);
+    
+    for (int32 i = 0; i < NumTiles; ++i)
+    {
+        if (i != SafeIndex)
+        {
+            ValidTileIndices.Add(i);
+        }
+    }
+    
+    // Partial Fisher-Yates shuffle: the first BombsToPlace entries become the bombs.
+    // Swapping instead of RemoveAt keeps this linear in the bomb count.
+    const int32 BombsToPlace = FMath::Min(InBombCount, ValidTileIndices.Num());
+    FRandomStream RandomStream(InSeed);
+    
+    OutBombIndices.Reset(BombsToPlace);
+    for (int32 i = 0; i < BombsToPlace; ++i)
+    {
+        const int32 RandomIndex = RandomStream.RandRange(i, ValidTileIndices.Num() - 1);
+        ValidTileIndices.Swap(i, RandomIndex);
+        OutBombIndices.Add(ValidTileIndices[i]);
+    }
+}
+
+void FMinesweeperGame::CalculateAdjacentBombs()
+{
+    // For each tile, count adjacent bombs, a chunk at a time
+    for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+    {
+        const int32 FirstTile = ChunkIndex << ChunkShift;
+        FChunk& Chunk = GetMutableChunk(FirstTile);
+        
+        for (int32 TileIndex = FirstTile; TileIndex < FirstTile + ChunkTiles; ++TileIndex)
+        {
+            int32 X, Y;
+            GetTileCoordinates(TileIndex, X, Y);
+            
+            // Tiles past the edge of the board only pad out the last chunks
+            if (IsValidCoordinate(X, Y) && !GetBit(Chunk.BombBits, TileIndex))
+            {
+                int32 AdjacentBombs = 0;
+                
+                const int32 LocalX = TileIndex & (TileSide - 1);
+                const int32 LocalY = (TileIndex & (ChunkTiles - 1)) >> TileShift;
+                if (Layout == EBoardLayout::Tiled && LocalX > 0 && LocalX < TileSide - 1 && LocalY > 0 && LocalY < TileSide - 1)
+                {
+                    // Away from the edges of a tiled chunk every neighbor is in the same chunk
+                    for (const int32 Offset : { -TileSide - 1, -TileSide, -TileSide + 1, -1, 1, TileSide - 1, TileSide, TileSide + 1 })
+                    {
+                        AdjacentBombs += GetBit(Chunk.BombBits, TileIndex + Offset) ? 1 : 0;
+                    }
+                }
+                else
+                {
+                    // Check all 8 surrounding tiles
+                    for (int32 DY = -1; DY <= 1; ++DY)
+                    {
+                        for (int32 DX = -1; DX <= 1; ++DX)
+                        {
+                            // Skip the current tile
+                            if (DX == 0 && DY == 0)
+                            {
+                                continue;
+                            }
+                            
+                            int32 CheckX = X + DX;
+                            int32 CheckY = Y + DY;
+                            
+                            if (IsValidCoordinate(CheckX, CheckY))
+                            {
+                                const int32 CheckIndex = GetStorageIndex(CheckX, CheckY);
+                                AdjacentBombs += GetBit(GetChunk(CheckIndex).BombBits, CheckIndex) ? 1 : 0;
+                            }
+                        }
+                    }
+                }
+                
+                Chunk.AdjacentCounts[(TileIndex & (ChunkTiles - 1)) >> 1] |= AdjacentBombs << ((TileIndex & 1) * 4);
+            }
+        }
+    }
+}
+
+void FMinesweeperGame::FloodFillReveal(TArray<int32>* OutRevealedTiles)
+{
+    // Basic BFS to reveal empty tiles and their adjacent numbered tiles
+    TArray<TPair<int32, int32>>& Queue = Scratch.FloodQueue;
+    
+    for (int32 Head = 0; Head < Queue.Num(); ++Head)
+    {
+        int32 CurrentX = Queue[Head].Key;
+        int32 CurrentY = Queue[Head].Value;
+        
+        // Check all 8 surrounding tiles
+        for (int32 DY = -1; DY <= 1; ++DY)
+        {
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                int32 CheckX = CurrentX + DX;
+                int32 CheckY = CurrentY + DY;
+                
+                if (IsValidCoordinate(CheckX, CheckY))
+                {
+                    const int32 CheckIndex = GetStorageIndex(CheckX, CheckY);
+                    
+                    // Only process hidden, unflagged tiles, and don't reveal bombs
+                    const FChunk& CheckChunk = GetChunk(CheckIndex);
+                    if (!GetBit(CheckChunk.RevealedBits, CheckIndex) && !GetBit(CheckChunk.BombBits, CheckIndex) && !GetBit(CheckChunk.FlaggedBits, CheckIndex))
+                    {
+                        SetBit(GetMutableChunk(CheckIndex).RevealedBits, CheckIndex);
+                        RevealedTiles++;
+                        
+                        if (OutRevealedTiles)
+                        {
+                            OutRevealedTiles->Add(CheckY * Width + CheckX);
+                        }
+                        
+                        // If this is also an empty tile, add it to the queue
+                        if (GetAdjacentCount(CheckIndex) == 0)
+                        {
+                            Queue.Add(TPair<int32, int32>(CheckX, CheckY));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    Queue.Reset();
+}
+
+void FMinesweeperGame::CheckGameWon()
+{
+    // Game is won when all non-bomb tiles are revealed
+    if (RevealedTiles == (Width * Height - BombCount))
+    {
+        bGameWon = true;
+    }
+}
+
+const FMinesweeperGame::FChunkPtr& FMinesweeperGame::GetEmptyChunk()
+{
+    // Held here forever, so it is never unique and every write copies it first
+    static const FChunkPtr EmptyChunk = []()
+    {
+        FChunkPtr Chunk = MakeShared<FChunk, ESPMode::ThreadSafe>();
+        FMemory::Memzero(Chunk.Get(), sizeof(FChunk));
+        return Chunk;
+    }();
+    return EmptyChunk;
+}
+
+void FMinesweeperGame::ResetChunks()
+{
+    Paging.Reset();
+    
+    ChunksPerRow = FMath::DivideAndRoundUp(Width, TileSide);
+    const int32 NumChunks = Layout == EBoardLayout::RowMajor
+        ? FMath::DivideAndRoundUp(Width * Height, ChunkTiles)
+        : ChunksPerRow * FMath::DivideAndRoundUp(Height, TileSide);
+    
+    // Keep the chunks of the last game for this one to write into. History goes first, so the
+    // board's own chunks are no longer shared with it when they are recycled.
+    ClearHistory();
+    Scratch.SpareChunks.Reserve(Scratch.SpareChunks.Num() + Chunks.Num());
+    for (FChunkPtr& Chunk : Chunks)
+    {
+        RecycleChunk(Chunk);
+    }
+    if (Scratch.SpareChunks.Num() > NumChunks)
+    {
+        Scratch.SpareChunks.SetNum(NumChunks, false);
+    }
+    
+    // Reset rather than Init, which would reallocate whenever the chunk count changes
+    Chunks.Reset(NumChunks);
+    for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+    {
+        Chunks.Add(GetEmptyChunk());
+    }
+    ChunkChangeIds.Reset(NumChunks);
+    ChunkChangeIds.AddZeroed(NumChunks);
+    ChangeId = 0;
+    bRecordingChange = false;
+}
+
+void FMinesweeperGame::ClearHistory()
+{
+    for (TArray<FHistoryEntry>* History : { &UndoHistory, &RedoHistory })
+    {
+        for (FHistoryEntry& Entry : *History)
+        {
+            for (TPair<int32, FChunkPtr>& Chunk : Entry.Chunks)
+            {
+                RecycleChunk(Chunk.Value);
+            }
+        }
+        History->Reset();
+    }
+}
+
+void FMinesweeperGame::SetUndoEnabled(bool bEnabled)
+{
+    bUndoEnabled = bEnabled;
+    if (!bUndoEnabled)
+    {
+        ClearHistory();
+    }
+}
+
+FMinesweeperGame::FChunkPtr FMinesweeperGame::AllocateChunk() const
+{
+    return Scratch.SpareChunks.Num() > 0 ? Scratch.SpareChunks.Pop(false) : MakeShared<FChunk, ESPMode::ThreadSafe>();
+}
+
+void FMinesweeperGame::RecycleChunk(FChunkPtr& Chunk) const
+{
+    if (Chunk.IsValid() && Chunk.IsUnique() && Chunk != GetEmptyChunk())
+    {
+        // A read snapshot may just have let go of it on another thread; its reads come first
+        std::atomic_thread_fence(std::memory_order_acquire);
+        Scratch.SpareChunks.Add(MoveTemp(Chunk));
+    }
+    Chunk.Reset();
+}
+
+FMinesweeperGame::FChunk& FMinesweeperGame::GetMutableChunk(int32 TileIndex)
+{
+    const int32 ChunkIndex = TileIndex >> ChunkShift;
+    if (Paging.IsValid())
+    {
+        PageIn(ChunkIndex);
+        Paging->Flags[ChunkIndex] |= FPagingState::Dirty;
+    }
+    
+    FChunkPtr& Chunk = Chunks[ChunkIndex];
+    
+    // The first write of a move hands the current version to the history
+    if (bRecordingChange && ChunkChangeIds[ChunkIndex] != ChangeId)
+    {
+        ChunkChangeIds[ChunkIndex] = ChangeId;
+        UndoHistory.Last().Chunks.Emplace(ChunkIndex, Chunk);
+    }
+    
+    // Copy on write whenever anything else still references this version, including read
+    // snapshots on other threads; once they have let go, their reads come before our writes
+    if (!Chunk.IsUnique())
+    {
+        FChunkPtr Copy = AllocateChunk();
+        FMemory::Memcpy(Copy.Get(), Chunk.Get(), sizeof(FChunk));
+        Chunk = MoveTemp(Copy);
+    }
+    else
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    
+    return *Chunk;
+}
+
+void FMinesweeperGame::BeginChange()
+{
+    // Paged boards would have to keep every old chunk version in memory
+    if (Paging.IsValid() || !bUndoEnabled)
+    {
+        return;
+    }
+    
+    // A new move makes the redo history unreachable
+    RedoHistory.Reset();
+    
+    FHistoryEntry& Entry = UndoHistory.AddDefaulted_GetRef();
+    Entry.bGameOver = bGameOver;
+    Entry.bGameWon = bGameWon;
+    Entry.RevealedTiles = RevealedTiles;
+    Entry.MoveCount = MoveCount;
+    Entry.FlagCount = FlagCount;
+    
+    ChangeId++;
+    bRecordingChange = true;
+}
+
+void FMinesweeperGame::EndChange()
+{
+    bRecordingChange = false;
+}
+
+TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> FMinesweeperGame::FReadSnapshotSource::GetLatest() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Latest;
+}
+
+TSharedRef<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> FMinesweeperGame::GetReadSnapshotSource()
+{
+    if (!ReadSnapshots.IsValid())
+    {
+        ReadSnapshots = MakeShared<FReadSnapshotSource, ESPMode::ThreadSafe>();
+        PublishReadSnapshot();
+    }
+    return ReadSnapshots.ToSharedRef();
+}
+
+void FMinesweeperGame::PublishReadSnapshot()
+{
+    StateVersion++;
+    
+    if (!ReadSnapshots.IsValid())
+    {
+        return;
+    }
+    
+    // Only what GetTile and the getters read is copied; the chunks are shared, and the next move
+    // copies any chunk it writes to while a snapshot still holds it
+    TSharedPtr<FMinesweeperGame, ESPMode::ThreadSafe> Snapshot;
+    if (!Paging.IsValid())
+    {
+        Snapshot = MakeShared<FMinesweeperGame, ESPMode::ThreadSafe>();
+        Snapshot->Chunks = Chunks;
+        Snapshot->Layout = Layout;
+        Snapshot->ChunksPerRow = ChunksPerRow;
+        Snapshot->Width = Width;
+        Snapshot->Height = Height;
+        Snapshot->BombCount = BombCount;
+        Snapshot->Seed = Seed;
+        Snapshot->bGameOver = bGameOver;
+        Snapshot->bGameWon = bGameWon;
+        Snapshot->RevealedTiles = RevealedTiles;
+        Snapshot->MoveCount = MoveCount;
+        Snapshot->FlagCount = FlagCount;
+        Snapshot->StateVersion = StateVersion;
+    }
+    
+    // The previous snapshot is released outside the lock, in case this was its last reference
+    TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> Previous = MoveTemp(Snapshot);
+    {
+        FWriteScopeLock WriteLock(ReadSnapshots->Lock);
+        Swap(ReadSnapshots->Latest, Previous);
+    }
+}
+
+void FMinesweeperGame::GetTileCoordinates(int32 StorageIndex, int32& OutX, int32& OutY) const
+{
+    if (Layout == EBoardLayout::RowMajor)
+    {
+        OutX = StorageIndex % Width;
+        OutY = StorageIndex / Width;
+        return;
+    }
+    
+    const int32 ChunkIndex = StorageIndex >> ChunkShift;
+    OutX = (ChunkIndex % ChunksPerRow) * TileSide + (StorageIndex & (TileSide - 1));
+    OutY = (ChunkIndex / ChunksPerRow) * TileSide + ((StorageIndex & (ChunkTiles - 1)) >> TileShift);
+}
+
+const FMinesweeperGame::FChunk& FMinesweeperGame::PageIn(int32 ChunkIndex) const
+{
+    FPagingState& State = *Paging;
+    
+    if (State.Flags[ChunkIndex] & FPagingState::Resident)
+    {
+        State.Stats.Hits++;
+        if (State.Newest != ChunkIndex)
+        {
+            State.Unlink(ChunkIndex);
+            State.PushNewest(ChunkIndex);
+        }
+        return *Chunks[ChunkIndex];
+    }
+    
+    State.Stats.Misses++;
+    if (State.Stats.ResidentChunks >= State.Stats.MaxResidentChunks)
+    {
+        EvictOldestChunk();
+    }
+    
+    if (State.Flags[ChunkIndex] & FPagingState::OnDisk)
+    {
+        FChunkPtr Chunk = AllocateChunk();
+        
+        if (!State.File->Seek(int64(ChunkIndex) * sizeof(FChunk)) || !State.File->Read(reinterpret_cast<uint8*>(Chunk.Get()), sizeof(FChunk)))
+        {
+            UE_LOG(LogMinesweeperGame, Error, TEXT("Could not read chunk %d from %s"), ChunkIndex, *State.Filename);
+            FMemory::Memzero(Chunk.Get(), sizeof(FChunk));
+        }
+        
+        Chunks[ChunkIndex] = MoveTemp(Chunk);
+        State.Stats.PageIns++;
+    }
+    else
+    {
+        Chunks[ChunkIndex] = GetEmptyChunk();
+    }
+    
+    State.Flags[ChunkIndex] |= FPagingState::Resident;
+    State.PushNewest(ChunkIndex);
+    State.Stats.ResidentChunks++;
+    
+    return *Chunks[ChunkIndex];
+}
+
+void FMinesweeperGame::EvictOldestChunk() const
+{
+    FPagingState& State = *Paging;
+    const int32 ChunkIndex = State.Oldest;
+    State.Unlink(ChunkIndex);
+    
+    // Chunks are written back only if they changed since they were loaded
+    if (State.Flags[ChunkIndex] & FPagingState::Dirty)
+    {
+        if (!State.File->Seek(int64(ChunkIndex) * sizeof(FChunk)) || !State.File->Write(reinterpret_cast<const uint8*>(Chunks[ChunkIndex].Get()), sizeof(FChunk)))
+        {
+            UE_LOG(LogMinesweeperGame, Error, TEXT("Could not write chunk %d to %s"), ChunkIndex, *State.Filename);
+        }
+        State.Flags[ChunkIndex] |= FPagingState::OnDisk;
+        State.Stats.PageOuts++;
+    }
+    
+    RecycleChunk(Chunks[ChunkIndex]);
+    
+    State.Flags[ChunkIndex] &= ~(FPagingState::Resident | FPagingState::Dirty);
+    State.Stats.ResidentChunks--;
+}
+
+void FMinesweeperGame::PublishPagingStats() const
+{
+    const FPagingStats& Stats = Paging->Stats;
+    SET_FLOAT_STAT(STAT_MinesweeperChunkHitRate, float(Stats.GetHitRate()));
+    SET_DWORD_STAT(STAT_MinesweeperChunkPageIns, uint32(Stats.PageIns));
+    SET_DWORD_STAT(STAT_MinesweeperChunkPageOuts, uint32(Stats.PageOuts));
+    SET_DWORD_STAT(STAT_MinesweeperResidentChunks, uint32(Stats.ResidentChunks));
+}
+
+void FMinesweeperGame::SwapHistory(FHistoryEntry& Entry)
+{
+    for (TPair<int32, FChunkPtr>& Chunk : Entry.Chunks)
+    {
+        Swap(Chunks[Chunk.Key], Chunk.Value);
+    }
+    
+    Swap(bGameOver, Entry.bGameOver);
+    Swap(bGameWon, Entry.bGameWon);
+    Swap(RevealedTiles, Entry.RevealedTiles);
+    Swap(MoveCount, Entry.MoveCount);
+    Swap(FlagCount, Entry.FlagCount);
+}
@@ -0,0 +1,89 @@
+// MinesweeperHintService.cpp
+#include "MinesweeperHintService.h"
+#include "MinesweeperSolver.h"
+#include "Async/Async.h"
+
+FMinesweeperHintService::~FMinesweeperHintService()
+{
+    Cancel();
+}
+
+void FMinesweeperHintService::RequestHint(TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> Snapshot, FOnMinesweeperHintReady OnHintReady)
+{
+    Cancel();
+    
+    if (!Snapshot.IsValid())
+    {
+        return;
+    }
+    
+    TSharedRef<FRequest, ESPMode::ThreadSafe> Request = MakeShared<FRequest, ESPMode::ThreadSafe>();
+    ActiveRequest = Request;
+    
+    Async(EAsyncExecution::ThreadPool, [Request, Snapshot, OnHintReady]()
+    {
+        const FMinesweeperHint Hint = ComputeHint(*Snapshot, Request->bCancelled);
+        if (Request->bCancelled || Hint.X == INDEX_NONE)
+        {
+            return;
+        }
+        
+        // Cancelling happens on the game thread, so checking again there drops any result
+        // that was overtaken while it was being posted
+        AsyncTask(ENamedThreads::GameThread, [Request, Hint, OnHintReady]()
+        {
+            if (!Request->bCancelled)
+            {
+                OnHintReady.ExecuteIfBound(Hint);
+            }
+        });
+    });
+}
+
+void FMinesweeperHintService::Cancel()
+{
+    if (ActiveRequest.IsValid())
+    {
+        ActiveRequest->bCancelled = true;
+        ActiveRequest.Reset();
+    }
+}
+
+FMinesweeperHint FMinesweeperHintService::ComputeHint(const FMinesweeperGame& Snapshot, const std::atomic<bool>& bCancelled)
+{
+    FMinesweeperHint Hint;
+    Hint.StateVersion = Snapshot.GetStateVersion();
+    
+    // Nothing to suggest before the first click or after the game has ended
+    if (Snapshot.GetMoveCount() == 0 || Snapshot.IsGameOver() || Snapshot.IsGameWon())
+    {
+        return Hint;
+    }
+    
+    FMinesweeperSolver Solver;
+    Solver.SetCancelFlag(&bCancelled);
+    
+    FMinesweeperSolver::FBoardView View;
+    FMinesweeperSolver::MakeView(Snapshot, View);
+    
+    // A proven safe tile beats any guess; the first one found is as good as the rest
+    TArray<int32> SafeTiles;
+    int32 TileIndex = INDEX_NONE;
+    if (Solver.Solve(View, SafeTiles))
+    {
+        TileIndex = SafeTiles[0];
+        Hint.bSafe = true;
+    }
+    else
+    {
+        TileIndex = Solver.FindLowestRiskTile(View, &Hint.Risk);
+    }
+    
+    if (TileIndex != INDEX_NONE && !Solver.IsCancelled())
+    {
+        Hint.X = TileIndex % View.Width;
+        Hint.Y = TileIndex / View.Width;
+    }
+    
+    return Hint;
+}
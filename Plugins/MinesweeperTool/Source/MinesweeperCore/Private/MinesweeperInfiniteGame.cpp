@@ -0,0 +1,344 @@
+// MinesweeperInfiniteGame.cpp
+#include "MinesweeperInfiniteGame.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperInfinite, Log, All);
+
+namespace MinesweeperInfiniteGame
+{
+    // SplitMix64 finalizer: every input bit affects every output bit, so neighboring
+    // chunk coordinates and huge coordinates hash equally well
+    uint64 Mix(uint64 Value)
+    {
+        Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+        return Value ^ (Value >> 31);
+    }
+
+    constexpr uint64 Golden = 0x9E3779B97F4A7C15ull;
+}
+
+FMinesweeperInfiniteGame::FMinesweeperInfiniteGame()
+    : NumGeneratedChunks(0)
+    , NumTouchedChunks(0)
+    , Seed(0)
+    , BombDensity(DefaultBombDensity)
+    , BombThreshold(0)
+    , bHasFirstClick(false)
+    , FirstClick(0, 0)
+    , ExplodedTile(0, 0)
+    , bGameOver(false)
+    , RevealedTiles(0)
+    , MoveCount(0)
+{
+}
+
+void FMinesweeperInfiniteGame::NewGame(int32 InSeed, float InBombDensity)
+{
+    Seed = InSeed;
+    BombDensity = FMath::Clamp(InBombDensity, MinBombDensity, MaxBombDensity);
+    BombThreshold = uint32(double(BombDensity) * 4294967296.0);
+
+    // Reset game state
+    bHasFirstClick = false;
+    bGameOver = false;
+    RevealedTiles = 0;
+    MoveCount = 0;
+
+    Chunks.Reset();
+    NumGeneratedChunks = 0;
+    NumTouchedChunks = 0;
+    FloodFrontier.Reset();
+}
+
+bool FMinesweeperInfiniteGame::RevealTile(int64 X, int64 Y)
+{
+    if (bGameOver || IsRevealed(X, Y))
+    {
+        return false;
+    }
+
+    // First click - chunks generated so far may have mines around it, so start over
+    if (!bHasFirstClick)
+    {
+        bHasFirstClick = true;
+        FirstClick = FInt64Point(X, Y);
+        Chunks.Reset();
+    }
+
+    MoveCount++;
+
+    FChunk& Chunk = GetTouchedChunk(X, Y);
+    const uint64 Bit = 1ull << (X & (ChunkSize - 1));
+
+    if (Chunk.BombRows[Y & (ChunkSize - 1)] & Bit)
+    {
+        // Game over
+        bGameOver = true;
+        ExplodedTile = FInt64Point(X, Y);
+        return true;
+    }
+
+    // Reveal this tile
+    Chunk.RevealedRows[Y & (ChunkSize - 1)] |= Bit;
+    RevealedTiles++;
+
+    // If this is an empty tile, reveal surrounding tiles, along with any a capped flood left
+    if (CountAdjacentBombs(X, Y) == 0)
+    {
+        FloodFrontier.Add(FInt64Point(X, Y));
+    }
+    if (FloodFrontier.Num() > 0)
+    {
+        FloodFillReveal();
+    }
+
+    if (GetNumCachedChunks() > MaxCachedChunks)
+    {
+        EvictUntouchedChunks();
+    }
+
+    return true;
+}
+
+FMinesweeperGame::FTile FMinesweeperInfiniteGame::GetTile(int64 X, int64 Y) const
+{
+    // A scrolling viewport would otherwise keep every chunk it ever passed over
+    if (GetNumCachedChunks() > MaxCachedChunks)
+    {
+        EvictUntouchedChunks();
+    }
+
+    const FChunk& Chunk = FindOrGenerateChunk(X >> ChunkShift, Y >> ChunkShift);
+    const uint64 Bit = 1ull << (X & (ChunkSize - 1));
+
+    FMinesweeperGame::FTile Tile;
+    Tile.bIsBomb = (Chunk.BombRows[Y & (ChunkSize - 1)] & Bit) != 0;
+
+    if (bGameOver && ExplodedTile == FInt64Point(X, Y))
+    {
+        Tile.State = FMinesweeperGame::ETileState::Exploded;
+    }
+    else if ((Chunk.RevealedRows[Y & (ChunkSize - 1)] & Bit) || (bGameOver && Tile.bIsBomb))
+    {
+        Tile.State = FMinesweeperGame::ETileState::Revealed;
+    }
+
+    // Counts are only needed once a tile is shown, and would otherwise generate its neighbors
+    if (!Tile.bIsBomb && Tile.State == FMinesweeperGame::ETileState::Revealed)
+    {
+        Tile.AdjacentBombs = CountAdjacentBombs(X, Y);
+    }
+
+    return Tile;
+}
+
+void FMinesweeperInfiniteGame::EvictUntouchedChunks() const
+{
+    for (auto It = Chunks.CreateIterator(); It; ++It)
+    {
+        if (!It.Value()->bTouched)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+const FMinesweeperInfiniteGame::FChunk& FMinesweeperInfiniteGame::FindOrGenerateChunk(int64 ChunkX, int64 ChunkY) const
+{
+    const FInt64Point Key(ChunkX, ChunkY);
+    if (const TUniquePtr<FChunk>* Found = Chunks.Find(Key))
+    {
+        return **Found;
+    }
+
+    TUniquePtr<FChunk>& Chunk = Chunks.Add(Key, MakeUnique<FChunk>());
+    GenerateChunk(ChunkX, ChunkY, *Chunk);
+    NumGeneratedChunks++;
+
+    return *Chunk;
+}
+
+FMinesweeperInfiniteGame::FChunk& FMinesweeperInfiniteGame::GetTouchedChunk(int64 X, int64 Y)
+{
+    // Chunks live behind unique pointers, so this stays valid while others are added
+    FChunk& Chunk = const_cast<FChunk&>(FindOrGenerateChunk(X >> ChunkShift, Y >> ChunkShift));
+    if (!Chunk.bTouched)
+    {
+        Chunk.bTouched = true;
+        NumTouchedChunks++;
+    }
+
+    return Chunk;
+}
+
+void FMinesweeperInfiniteGame::GenerateChunk(int64 ChunkX, int64 ChunkY, FChunk& OutChunk) const
+{
+    using namespace MinesweeperInfiniteGame;
+
+    // Each tile draws from a stream seeded by the hash of (seed, chunk coordinate), so a
+    // chunk comes out the same no matter when or in which order it is generated
+    uint64 State = Mix(Mix(Mix(uint64(uint32(Seed)) + Golden) ^ uint64(ChunkX)) ^ uint64(ChunkY));
+
+    for (int32 Row = 0; Row < ChunkSize; ++Row)
+    {
+        uint64 Bombs = 0;
+        for (int32 Column = 0; Column < ChunkSize; ++Column)
+        {
+            State += Golden;
+            if (uint32(Mix(State) >> 32) < BombThreshold)
+            {
+                Bombs |= 1ull << Column;
+            }
+        }
+
+        OutChunk.BombRows[Row] = Bombs;
+        OutChunk.RevealedRows[Row] = 0;
+    }
+    OutChunk.bTouched = false;
+
+    // Keep the first click and its neighbors clear so the game opens up
+    if (bHasFirstClick)
+    {
+        for (int64 DY = -1; DY <= 1; ++DY)
+        {
+            for (int64 DX = -1; DX <= 1; ++DX)
+            {
+                const int64 SafeX = FirstClick.X + DX;
+                const int64 SafeY = FirstClick.Y + DY;
+                if ((SafeX >> ChunkShift) == ChunkX && (SafeY >> ChunkShift) == ChunkY)
+                {
+                    OutChunk.BombRows[SafeY & (ChunkSize - 1)] &= ~(1ull << (SafeX & (ChunkSize - 1)));
+                }
+            }
+        }
+    }
+}
+
+bool FMinesweeperInfiniteGame::IsBomb(int64 X, int64 Y) const
+{
+    const FChunk& Chunk = FindOrGenerateChunk(X >> ChunkShift, Y >> ChunkShift);
+    return (Chunk.BombRows[Y & (ChunkSize - 1)] >> (X & (ChunkSize - 1))) & 1;
+}
+
+bool FMinesweeperInfiniteGame::IsRevealed(int64 X, int64 Y) const
+{
+    // Tiles in chunks that are not loaded have never been revealed
+    const TUniquePtr<FChunk>* Chunk = Chunks.Find(FInt64Point(X >> ChunkShift, Y >> ChunkShift));
+    return Chunk && (((*Chunk)->RevealedRows[Y & (ChunkSize - 1)] >> (X & (ChunkSize - 1))) & 1);
+}
+
+int32 FMinesweeperInfiniteGame::CountAdjacentBombs(int64 X, int64 Y) const
+{
+    const int32 LocalX = int32(X & (ChunkSize - 1));
+    const int32 LocalY = int32(Y & (ChunkSize - 1));
+
+    // Inside a chunk, the three rows give all 8 neighbors with a mask and a popcount
+    if (LocalX > 0 && LocalX < ChunkSize - 1 && LocalY > 0 && LocalY < ChunkSize - 1)
+    {
+        const FChunk& Chunk = FindOrGenerateChunk(X >> ChunkShift, Y >> ChunkShift);
+        const uint64 Mask = 7ull << (LocalX - 1);
+        return FMath::CountBits(Chunk.BombRows[LocalY - 1] & Mask)
+            + FMath::CountBits(Chunk.BombRows[LocalY] & Mask & ~(1ull << LocalX))
+            + FMath::CountBits(Chunk.BombRows[LocalY + 1] & Mask);
+    }
+
+    // On a chunk edge, check all 8 surrounding tiles
+    int32 AdjacentBombs = 0;
+    for (int64 DY = -1; DY <= 1; ++DY)
+    {
+        for (int64 DX = -1; DX <= 1; ++DX)
+        {
+            if ((DX != 0 || DY != 0) && IsBomb(X + DX, Y + DY))
+            {
+                AdjacentBombs++;
+            }
+        }
+    }
+    return AdjacentBombs;
+}
+
+void FMinesweeperInfiniteGame::FloodFillReveal()
+{
+    // Basic BFS to reveal empty tiles and their adjacent numbered tiles
+    TArray<FInt64Point>& Queue = FloodFrontier;
+
+    int32 Head = 0;
+    for (; Head < Queue.Num() && Head < MaxFloodTiles; ++Head)
+    {
+        const FInt64Point Current = Queue[Head];
+
+        // Check all 8 surrounding tiles
+        for (int64 DY = -1; DY <= 1; ++DY)
+        {
+            for (int64 DX = -1; DX <= 1; ++DX)
+            {
+                const int64 CheckX = Current.X + DX;
+                const int64 CheckY = Current.Y + DY;
+
+                // Only process hidden tiles, and don't reveal bombs
+                if (!IsRevealed(CheckX, CheckY) && !IsBomb(CheckX, CheckY))
+                {
+                    GetTouchedChunk(CheckX, CheckY).RevealedRows[CheckY & (ChunkSize - 1)] |= 1ull << (CheckX & (ChunkSize - 1));
+                    RevealedTiles++;
+
+                    // If this is also an empty tile, add it to the queue
+                    if (CountAdjacentBombs(CheckX, CheckY) == 0)
+                    {
+                        Queue.Add(FInt64Point(CheckX, CheckY));
+                    }
+                }
+            }
+        }
+    }
+
+    // The density floor keeps openings finite; the cap only guards against bad luck. Past it,
+    // the empty tiles not yet expanded stay queued and the next reveal carries on from them.
+    Queue.RemoveAt(0, Head, false);
+}
+
+static FAutoConsoleCommand InfiniteCompareCommand(
+    TEXT("Minesweeper.Infinite.Compare"),
+    TEXT("Play the first move of many unbounded games near the origin and far from it, and compare how they play. Usage: Minesweeper.Infinite.Compare [Games=200] [BombDensity=0.16]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 NumGames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 200;
+        const float Density = Args.Num() > 1 ? FCString::Atof(*Args[1]) : FMinesweeperInfiniteGame::DefaultBombDensity;
+
+        const int64 Origins[] = { 0, 1000000000ll, -1000000000ll };
+        for (const int64 Origin : Origins)
+        {
+            double TotalOpening = 0.0;
+            double TotalSeconds = 0.0;
+            int64 Bombs = 0;
+            int64 SampledTiles = 0;
+            int32 TouchedChunks = 0;
+
+            FMinesweeperInfiniteGame Game;
+            for (int32 GameIndex = 0; GameIndex < NumGames; ++GameIndex)
+            {
+                Game.NewGame(GameIndex + 1, Density);
+
+                const double StartTime = FPlatformTime::Seconds();
+                Game.RevealTile(Origin, Origin);
+                TotalSeconds += FPlatformTime::Seconds() - StartTime;
+                TotalOpening += double(Game.GetRevealedTiles());
+                TouchedChunks += Game.GetNumTouchedChunks();
+
+                // Sample the mine density in a window away from the safe first click
+                for (int64 Y = Origin + 100; Y < Origin + 164; ++Y)
+                {
+                    for (int64 X = Origin - 32; X < Origin + 32; ++X)
+                    {
+                        Bombs += Game.GetTile(X, Y).bIsBomb ? 1 : 0;
+                        SampledTiles++;
+                    }
+                }
+            }
+
+            UE_LOG(LogMinesweeperInfinite, Log, TEXT("Origin (%lld, %lld): density %.4f, first opening %.1f tiles, %.3f ms, %.1f chunks touched"),
+                (long long)Origin, (long long)Origin, double(Bombs) / double(SampledTiles), TotalOpening / NumGames,
+                TotalSeconds * 1000.0 / NumGames, double(TouchedChunks) / NumGames);
+        }
+    }));
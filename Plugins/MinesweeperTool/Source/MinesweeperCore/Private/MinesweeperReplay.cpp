@@ -0,0 +1,689 @@
+// MinesweeperReplay.cpp
+#include "MinesweeperReplay.h"
+#include "MinesweeperSnapshot.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperReplay, Log, All);
+
+namespace MinesweeperReplay
+{
+    void WriteVarint(TArray<uint8>& Bytes, uint32 Value)
+    {
+        while (Value >= 0x80)
+        {
+            Bytes.Add(uint8(Value | 0x80));
+            Value >>= 7;
+        }
+        Bytes.Add(uint8(Value));
+    }
+
+    bool ReadVarint(const TArray<uint8>& Bytes, int32& Offset, uint32& OutValue)
+    {
+        OutValue = 0;
+        for (int32 Shift = 0; Shift < 35; Shift += 7)
+        {
+            if (Offset >= Bytes.Num())
+            {
+                return false;
+            }
+
+            const uint8 Byte = Bytes[Offset++];
+            OutValue |= uint32(Byte & 0x7F) << Shift;
+            if ((Byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32 ZigZagEncode(int32 Value)
+    {
+        return (uint32(Value) << 1) ^ uint32(Value >> 31);
+    }
+
+    int32 ZigZagDecode(uint32 Value)
+    {
+        return int32(Value >> 1) ^ -int32(Value & 1);
+    }
+
+    void WriteInt32(TArray<uint8>& Bytes, int32 Value)
+    {
+        Bytes.Append(reinterpret_cast<const uint8*>(&Value), sizeof(int32));
+    }
+
+    int32 ReadInt32(const uint8* Bytes)
+    {
+        int32 Value;
+        FMemory::Memcpy(&Value, Bytes, sizeof(int32));
+        return Value;
+    }
+}
+
+void FMinesweeperReplay::Reset(int32 InWidth, int32 InHeight, int32 InBombCount, int32 InSeed)
+{
+    Width = InWidth;
+    Height = InHeight;
+    BombCount = InBombCount;
+    Seed = InSeed;
+    PreviousTileIndex = 0;
+    ActionBytes.Reset();
+}
+
+int32 FMinesweeperReplay::AddAction(EAction Type, int32 TileIndex, uint32 DeltaMilliseconds)
+{
+    using namespace MinesweeperReplay;
+
+    const int32 StartSize = ActionBytes.Num();
+
+    // Consecutive clicks are usually close together, so the index delta stays small
+    WriteVarint(ActionBytes, (ZigZagEncode(TileIndex - PreviousTileIndex) << 2) | uint32(Type));
+    WriteVarint(ActionBytes, DeltaMilliseconds);
+    PreviousTileIndex = TileIndex;
+
+    return ActionBytes.Num() - StartSize;
+}
+
+bool FMinesweeperReplay::ReadAction(FCursor& Cursor, FAction& OutAction) const
+{
+    using namespace MinesweeperReplay;
+
+    FCursor NextCursor = Cursor;
+    uint32 Code = 0;
+    uint32 DeltaMilliseconds = 0;
+
+    if (!ReadVarint(ActionBytes, NextCursor.Offset, Code) || !ReadVarint(ActionBytes, NextCursor.Offset, DeltaMilliseconds))
+    {
+        return false;
+    }
+
+    const uint32 Type = Code & 3;
+    if (Type > uint32(EAction::Chord))
+    {
+        return false;
+    }
+
+    NextCursor.PreviousTileIndex += ZigZagDecode(Code >> 2);
+
+    OutAction.Type = EAction(Type);
+    OutAction.TileIndex = NextCursor.PreviousTileIndex;
+    OutAction.DeltaMilliseconds = DeltaMilliseconds;
+    Cursor = NextCursor;
+
+    return true;
+}
+
+int32 FMinesweeperReplay::CountActions() const
+{
+    FCursor Cursor;
+    FAction Action;
+    int32 NumActions = 0;
+
+    while (ReadAction(Cursor, Action))
+    {
+        NumActions++;
+    }
+
+    return NumActions;
+}
+
+bool FMinesweeperReplay::Save(const FString& Filename) const
+{
+    TArray<uint8> Bytes;
+    WriteHeader(Bytes);
+    Bytes.Append(ActionBytes);
+
+    return FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+bool FMinesweeperReplay::Load(const FString& Filename)
+{
+    using namespace MinesweeperReplay;
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Filename) || Bytes.Num() < HeaderSize)
+    {
+        return false;
+    }
+
+    uint16 Version = 0;
+    FMemory::Memcpy(&Version, Bytes.GetData() + 4, sizeof(uint16));
+    if (uint32(ReadInt32(Bytes.GetData())) != Magic || Version > CurrentVersion)
+    {
+        UE_LOG(LogMinesweeperReplay, Error, TEXT("%s is not a minesweeper replay"), *Filename);
+        return false;
+    }
+
+    Reset(ReadInt32(Bytes.GetData() + 8), ReadInt32(Bytes.GetData() + 12), ReadInt32(Bytes.GetData() + 16), ReadInt32(Bytes.GetData() + 20));
+    ActionBytes.Append(Bytes.GetData() + HeaderSize, Bytes.Num() - HeaderSize);
+
+    // Keep appending after the last complete action
+    FCursor Cursor;
+    FAction Action;
+    while (ReadAction(Cursor, Action))
+    {
+    }
+    ActionBytes.SetNum(Cursor.Offset);
+    PreviousTileIndex = Cursor.PreviousTileIndex;
+
+    return true;
+}
+
+void FMinesweeperReplay::WriteHeader(TArray<uint8>& OutBytes) const
+{
+    using namespace MinesweeperReplay;
+
+    const uint16 Version = CurrentVersion;
+    const uint16 Flags = 0;
+
+    WriteInt32(OutBytes, int32(Magic));
+    OutBytes.Append(reinterpret_cast<const uint8*>(&Version), sizeof(uint16));
+    OutBytes.Append(reinterpret_cast<const uint8*>(&Flags), sizeof(uint16));
+    WriteInt32(OutBytes, Width);
+    WriteInt32(OutBytes, Height);
+    WriteInt32(OutBytes, BombCount);
+    WriteInt32(OutBytes, Seed);
+}
+
+void FMinesweeperReplay::StartGame(FMinesweeperGame& Game) const
+{
+    Game.NewGame(Width, Height, BombCount, Seed);
+}
+
+FMinesweeperReplayRecorder::FMinesweeperReplayRecorder()
+    : LastActionTime(0.0)
+    , bRecording(false)
+{
+}
+
+FMinesweeperReplayRecorder::~FMinesweeperReplayRecorder()
+{
+    End();
+}
+
+void FMinesweeperReplayRecorder::Begin(const FMinesweeperGame& Game, const FString& Filename)
+{
+    End();
+
+    Replay.Reset(Game.GetWidth(), Game.GetHeight(), Game.GetBombCount(), Game.GetSeed());
+    LastActionTime = FPlatformTime::Seconds();
+    bRecording = true;
+
+    if (!Filename.IsEmpty())
+    {
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+        FileHandle.Reset(PlatformFile.OpenWrite(*Filename));
+
+        if (FileHandle)
+        {
+            TArray<uint8> Header;
+            Replay.WriteHeader(Header);
+            FileHandle->Write(Header.GetData(), Header.Num());
+            FileHandle->Flush();
+        }
+    }
+}
+
+void FMinesweeperReplayRecorder::RecordAction(FMinesweeperReplay::EAction Type, int32 TileIndex)
+{
+    if (!bRecording)
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    const uint32 DeltaMilliseconds = uint32(FMath::Max(0.0, (Now - LastActionTime) * 1000.0));
+    LastActionTime = Now;
+
+    const int32 NumBytes = Replay.AddAction(Type, TileIndex, DeltaMilliseconds);
+
+    // Append just the new record so the file is always a valid log
+    if (FileHandle)
+    {
+        const TArray<uint8>& ActionBytes = Replay.GetActionBytes();
+        FileHandle->Write(ActionBytes.GetData() + ActionBytes.Num() - NumBytes, NumBytes);
+        FileHandle->Flush();
+    }
+}
+
+void FMinesweeperReplayRecorder::End()
+{
+    FileHandle.Reset();
+    bRecording = false;
+}
+
+FMinesweeperReplayPlayer::FMinesweeperReplayPlayer(const FMinesweeperReplay& InReplay)
+    : Replay(InReplay)
+    , bHasPendingAction(false)
+    , ActionIndex(0)
+    , PendingActionTimeMilliseconds(0)
+    , LastActionTimeMilliseconds(0)
+{
+}
+
+void FMinesweeperReplayPlayer::Start(FMinesweeperGame& Game)
+{
+    Replay.StartGame(Game);
+
+    Cursor = FMinesweeperReplay::FCursor();
+    ActionIndex = 0;
+    LastActionTimeMilliseconds = 0;
+    ReadPendingAction();
+}
+
+bool FMinesweeperReplayPlayer::Step(FMinesweeperGame& Game)
+{
+    if (!bHasPendingAction)
+    {
+        return false;
+    }
+
+    ApplyAction(Game, PendingAction);
+    ActionIndex++;
+    LastActionTimeMilliseconds = PendingActionTimeMilliseconds;
+
+    ReadPendingAction();
+
+    return true;
+}
+
+void FMinesweeperReplayPlayer::AdvanceTo(FMinesweeperGame& Game, double PlaybackSeconds)
+{
+    while (bHasPendingAction && PendingActionTimeMilliseconds <= PlaybackSeconds * 1000.0)
+    {
+        Step(Game);
+    }
+}
+
+void FMinesweeperReplayPlayer::SeekToTime(FMinesweeperGame& Game, double PlaybackSeconds, const FMinesweeperReplayKeyframes* Keyframes)
+{
+    const uint64 TargetMilliseconds = uint64(FMath::Max(0.0, PlaybackSeconds * 1000.0));
+    const bool bBackwards = ActionIndex > 0 && TargetMilliseconds < LastActionTimeMilliseconds;
+
+    const int32 KeyframeIndex = Keyframes && Keyframes->IsBuiltFrom(Replay) ? Keyframes->FindByTime(TargetMilliseconds) : INDEX_NONE;
+    if (KeyframeIndex != INDEX_NONE && (bBackwards || Keyframes->GetKeyframe(KeyframeIndex).ActionIndex > ActionIndex))
+    {
+        Restore(Game, *Keyframes, KeyframeIndex);
+    }
+    else if (bBackwards)
+    {
+        Start(Game);
+    }
+
+    AdvanceTo(Game, PlaybackSeconds);
+}
+
+void FMinesweeperReplayPlayer::SeekToAction(FMinesweeperGame& Game, int32 TargetActionIndex, const FMinesweeperReplayKeyframes* Keyframes)
+{
+    const bool bBackwards = TargetActionIndex < ActionIndex;
+
+    const int32 KeyframeIndex = Keyframes && Keyframes->IsBuiltFrom(Replay) ? Keyframes->FindByAction(TargetActionIndex) : INDEX_NONE;
+    if (KeyframeIndex != INDEX_NONE && (bBackwards || Keyframes->GetKeyframe(KeyframeIndex).ActionIndex > ActionIndex))
+    {
+        Restore(Game, *Keyframes, KeyframeIndex);
+    }
+    else if (bBackwards)
+    {
+        Start(Game);
+    }
+
+    while (ActionIndex < TargetActionIndex && Step(Game))
+    {
+    }
+}
+
+void FMinesweeperReplayPlayer::Restore(FMinesweeperGame& Game, const FMinesweeperReplayKeyframes& Keyframes, int32 KeyframeIndex)
+{
+    const FMinesweeperReplayKeyframes::FKeyframe& Keyframe = Keyframes.GetKeyframe(KeyframeIndex);
+    if (!FMinesweeperSnapshot::LoadFromMemory(Game, Keyframe.Snapshot))
+    {
+        Start(Game);
+        return;
+    }
+
+    Cursor = Keyframe.Cursor;
+    ActionIndex = Keyframe.ActionIndex;
+    LastActionTimeMilliseconds = Keyframe.PlaybackMilliseconds;
+    ReadPendingAction();
+}
+
+void FMinesweeperReplayPlayer::ReadPendingAction()
+{
+    bHasPendingAction = Replay.ReadAction(Cursor, PendingAction);
+    PendingActionTimeMilliseconds = LastActionTimeMilliseconds + (bHasPendingAction ? PendingAction.DeltaMilliseconds : 0);
+}
+
+bool FMinesweeperReplayPlayer::IsFinished() const
+{
+    return !bHasPendingAction;
+}
+
+FMinesweeperReplayPlayer::FRunStats FMinesweeperReplayPlayer::RunHeadless(const FMinesweeperReplay& Replay, FMinesweeperGame& Game)
+{
+    FRunStats Stats;
+    FMinesweeperReplay::FCursor Cursor;
+    FMinesweeperReplay::FAction Action;
+
+    const double StartTime = FPlatformTime::Seconds();
+    Replay.StartGame(Game);
+
+    // Recorded timing is ignored; every action is applied back to back
+    while (Replay.ReadAction(Cursor, Action))
+    {
+        const double ActionStart = FPlatformTime::Seconds();
+        ApplyAction(Game, Action);
+        const double ActionSeconds = FPlatformTime::Seconds() - ActionStart;
+
+        if (ActionSeconds > Stats.SlowestActionSeconds)
+        {
+            Stats.SlowestActionSeconds = ActionSeconds;
+            Stats.SlowestActionIndex = Stats.NumActions;
+        }
+        Stats.NumActions++;
+    }
+
+    Stats.TotalSeconds = FPlatformTime::Seconds() - StartTime;
+    return Stats;
+}
+
+bool FMinesweeperReplayPlayer::ApplyAction(FMinesweeperGame& Game, const FMinesweeperReplay::FAction& Action)
+{
+    const int32 X = Action.TileIndex % FMath::Max(1, Game.GetWidth());
+    const int32 Y = Action.TileIndex / FMath::Max(1, Game.GetWidth());
+
+    switch (Action.Type)
+    {
+        case FMinesweeperReplay::EAction::Reveal:
+            return Game.RevealTile(X, Y);
+        case FMinesweeperReplay::EAction::Flag:
+            return Game.ToggleFlag(X, Y);
+        case FMinesweeperReplay::EAction::Chord:
+            return Game.ChordTile(X, Y);
+        default:
+            return false;
+    }
+}
+
+void FMinesweeperReplayKeyframes::Build(const FMinesweeperReplay& Replay, int32 InInterval)
+{
+    Keyframes.Reset();
+    Interval = FMath::Max(1, InInterval);
+    ReplaySeed = Replay.GetSeed();
+    ReplayBytes = Replay.GetActionBytes().Num();
+
+    FMinesweeperGame Game;
+    FMinesweeperReplay::FCursor Cursor;
+    FMinesweeperReplay::FAction Action;
+    uint64 PlaybackMilliseconds = 0;
+    int32 ActionIndex = 0;
+
+    auto AddKeyframe = [&]()
+    {
+        FKeyframe& Keyframe = Keyframes.AddDefaulted_GetRef();
+        Keyframe.ActionIndex = ActionIndex;
+        Keyframe.Cursor = Cursor;
+        Keyframe.PlaybackMilliseconds = PlaybackMilliseconds;
+        FMinesweeperSnapshot::SaveToMemory(Game, Keyframe.Snapshot, FMinesweeperSnapshot::ECompression::LZ4);
+    };
+
+    Replay.StartGame(Game);
+    AddKeyframe();
+
+    while (Replay.ReadAction(Cursor, Action))
+    {
+        FMinesweeperReplayPlayer::ApplyAction(Game, Action);
+        ActionIndex++;
+        PlaybackMilliseconds += Action.DeltaMilliseconds;
+
+        if (ActionIndex % Interval == 0)
+        {
+            AddKeyframe();
+        }
+    }
+
+    NumActions = ActionIndex;
+    DurationMilliseconds = PlaybackMilliseconds;
+}
+
+int32 FMinesweeperReplayKeyframes::FindByAction(int32 ActionIndex) const
+{
+    // Keyframes sit at every multiple of the interval
+    return Keyframes.Num() > 0 ? FMath::Clamp(ActionIndex / Interval, 0, Keyframes.Num() - 1) : INDEX_NONE;
+}
+
+int32 FMinesweeperReplayKeyframes::FindByTime(uint64 PlaybackMilliseconds) const
+{
+    // Binary search for the last keyframe at or before the time
+    int32 Low = 0;
+    int32 High = Keyframes.Num();
+    while (Low < High)
+    {
+        const int32 Mid = (Low + High) / 2;
+        if (Keyframes[Mid].PlaybackMilliseconds <= PlaybackMilliseconds)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+
+    return Keyframes.Num() > 0 ? FMath::Max(Low - 1, 0) : INDEX_NONE;
+}
+
+int64 FMinesweeperReplayKeyframes::GetAllocatedSize() const
+{
+    int64 Size = Keyframes.GetAllocatedSize();
+    for (const FKeyframe& Keyframe : Keyframes)
+    {
+        Size += Keyframe.Snapshot.GetAllocatedSize();
+    }
+    return Size;
+}
+
+bool FMinesweeperReplayKeyframes::IsBuiltFrom(const FMinesweeperReplay& Replay) const
+{
+    return Keyframes.Num() > 0 && ReplaySeed == Replay.GetSeed() && ReplayBytes == Replay.GetActionBytes().Num();
+}
+
+bool FMinesweeperReplayKeyframes::Save(const FString& Filename) const
+{
+    using namespace MinesweeperReplay;
+
+    const uint16 Version = CurrentVersion;
+    const uint16 Flags = 0;
+
+    TArray<uint8> Bytes;
+    WriteInt32(Bytes, int32(Magic));
+    Bytes.Append(reinterpret_cast<const uint8*>(&Version), sizeof(uint16));
+    Bytes.Append(reinterpret_cast<const uint8*>(&Flags), sizeof(uint16));
+    WriteInt32(Bytes, Interval);
+    WriteInt32(Bytes, NumActions);
+    Bytes.Append(reinterpret_cast<const uint8*>(&DurationMilliseconds), sizeof(uint64));
+    WriteInt32(Bytes, ReplaySeed);
+    WriteInt32(Bytes, ReplayBytes);
+    WriteInt32(Bytes, Keyframes.Num());
+
+    for (const FKeyframe& Keyframe : Keyframes)
+    {
+        WriteInt32(Bytes, Keyframe.ActionIndex);
+        WriteInt32(Bytes, Keyframe.Cursor.Offset);
+        WriteInt32(Bytes, Keyframe.Cursor.PreviousTileIndex);
+        Bytes.Append(reinterpret_cast<const uint8*>(&Keyframe.PlaybackMilliseconds), sizeof(uint64));
+        WriteInt32(Bytes, Keyframe.Snapshot.Num());
+        Bytes.Append(Keyframe.Snapshot);
+    }
+
+    return FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+bool FMinesweeperReplayKeyframes::Load(const FString& Filename)
+{
+    Keyframes.Reset();
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Filename))
+    {
+        return false;
+    }
+
+    int32 Offset = 0;
+    auto Read = [&Bytes, &Offset](void* Dest, int32 Size)
+    {
+        if (Size < 0 || Offset + Size > Bytes.Num())
+        {
+            return false;
+        }
+        FMemory::Memcpy(Dest, Bytes.GetData() + Offset, Size);
+        Offset += Size;
+        return true;
+    };
+
+    uint32 FileMagic = 0;
+    uint16 Version = 0;
+    uint16 Flags = 0;
+    int32 NumKeyframes = 0;
+    if (!Read(&FileMagic, sizeof(uint32)) || !Read(&Version, sizeof(uint16)) || !Read(&Flags, sizeof(uint16))
+        || FileMagic != Magic || Version != CurrentVersion
+        || !Read(&Interval, sizeof(int32)) || !Read(&NumActions, sizeof(int32)) || !Read(&DurationMilliseconds, sizeof(uint64))
+        || !Read(&ReplaySeed, sizeof(int32)) || !Read(&ReplayBytes, sizeof(int32)) || !Read(&NumKeyframes, sizeof(int32))
+        || Interval <= 0 || NumKeyframes < 0)
+    {
+        UE_LOG(LogMinesweeperReplay, Error, TEXT("%s is not a replay keyframe file"), *Filename);
+        return false;
+    }
+
+    for (int32 Index = 0; Index < NumKeyframes; ++Index)
+    {
+        FKeyframe& Keyframe = Keyframes.AddDefaulted_GetRef();
+        int32 SnapshotSize = 0;
+        if (!Read(&Keyframe.ActionIndex, sizeof(int32)) || !Read(&Keyframe.Cursor.Offset, sizeof(int32))
+            || !Read(&Keyframe.Cursor.PreviousTileIndex, sizeof(int32)) || !Read(&Keyframe.PlaybackMilliseconds, sizeof(uint64))
+            || !Read(&SnapshotSize, sizeof(int32)) || SnapshotSize < 0 || Offset + SnapshotSize > Bytes.Num())
+        {
+            UE_LOG(LogMinesweeperReplay, Error, TEXT("%s is truncated"), *Filename);
+            Keyframes.Reset();
+            return false;
+        }
+
+        Keyframe.Snapshot.Append(Bytes.GetData() + Offset, SnapshotSize);
+        Offset += SnapshotSize;
+    }
+
+    return true;
+}
+
+FString FMinesweeperReplayKeyframes::GetKeyframePath(const FString& ReplayFilename)
+{
+    return FPaths::ChangeExtension(ReplayFilename, TEXT("mskeys"));
+}
+
+static FAutoConsoleCommand ReplayBenchmarkCommand(
+    TEXT("Minesweeper.Replay.Benchmark"),
+    TEXT("Re-run replays headless at full speed. Usage: Minesweeper.Replay.Benchmark <ReplayFile|Directory> [Repeats=1]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        if (Args.Num() < 1)
+        {
+            UE_LOG(LogMinesweeperReplay, Warning, TEXT("Usage: Minesweeper.Replay.Benchmark <ReplayFile|Directory> [Repeats=1]"));
+            return;
+        }
+
+        const int32 Repeats = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1;
+
+        TArray<FString> Filenames;
+        if (IFileManager::Get().DirectoryExists(*Args[0]))
+        {
+            IFileManager::Get().FindFiles(Filenames, *(Args[0] / TEXT("*.msreplay")), true, false);
+            for (FString& Filename : Filenames)
+            {
+                Filename = Args[0] / Filename;
+            }
+        }
+        else
+        {
+            Filenames.Add(Args[0]);
+        }
+
+        FMinesweeperGame Game;
+        for (const FString& Filename : Filenames)
+        {
+            FMinesweeperReplay Replay;
+            if (!Replay.Load(Filename))
+            {
+                continue;
+            }
+
+            FMinesweeperReplayPlayer::FRunStats Slowest;
+            double TotalSeconds = 0.0;
+            for (int32 Run = 0; Run < Repeats; ++Run)
+            {
+                const FMinesweeperReplayPlayer::FRunStats Stats = FMinesweeperReplayPlayer::RunHeadless(Replay, Game);
+                TotalSeconds += Stats.TotalSeconds;
+                if (Stats.SlowestActionSeconds > Slowest.SlowestActionSeconds)
+                {
+                    Slowest = Stats;
+                }
+            }
+
+            UE_LOG(LogMinesweeperReplay, Log, TEXT("%s: %dx%d, %d actions, %.3f ms per run, slowest action #%d took %.3f ms"),
+                *FPaths::GetCleanFilename(Filename), Replay.GetWidth(), Replay.GetHeight(), Replay.CountActions(),
+                TotalSeconds * 1000.0 / Repeats, Slowest.SlowestActionIndex, Slowest.SlowestActionSeconds * 1000.0);
+        }
+    }));
+
+static FAutoConsoleCommand ReplaySeekCommand(
+    TEXT("Minesweeper.Replay.Seek"),
+    TEXT("Time seeking a replay with and without keyframes, building the .mskeys file if needed. Usage: Minesweeper.Replay.Seek <ReplayFile> <ActionIndex> [Interval]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        if (Args.Num() < 2)
+        {
+            UE_LOG(LogMinesweeperReplay, Warning, TEXT("Usage: Minesweeper.Replay.Seek <ReplayFile> <ActionIndex> [Interval]"));
+            return;
+        }
+
+        FMinesweeperReplay Replay;
+        if (!Replay.Load(Args[0]))
+        {
+            return;
+        }
+
+        const int32 TargetActionIndex = FMath::Max(0, FCString::Atoi(*Args[1]));
+        const int32 Interval = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : FMinesweeperReplayKeyframes::DefaultInterval;
+        const FString KeyframePath = FMinesweeperReplayKeyframes::GetKeyframePath(Args[0]);
+
+        FMinesweeperReplayKeyframes Keyframes;
+        if (!Keyframes.Load(KeyframePath) || !Keyframes.IsBuiltFrom(Replay) || Keyframes.GetInterval() != Interval)
+        {
+            const double BuildStart = FPlatformTime::Seconds();
+            Keyframes.Build(Replay, Interval);
+            Keyframes.Save(KeyframePath);
+            UE_LOG(LogMinesweeperReplay, Log, TEXT("Built %d keyframes (%.1f MB) in %.1f ms"),
+                Keyframes.Num(), Keyframes.GetAllocatedSize() / (1024.0 * 1024.0), (FPlatformTime::Seconds() - BuildStart) * 1000.0);
+        }
+
+        FMinesweeperGame Game;
+
+        double StartTime = FPlatformTime::Seconds();
+        FMinesweeperReplayPlayer FromStart(Replay);
+        FromStart.Start(Game);
+        FromStart.SeekToAction(Game, TargetActionIndex);
+        const double FromStartSeconds = FPlatformTime::Seconds() - StartTime;
+
+        StartTime = FPlatformTime::Seconds();
+        FMinesweeperReplayPlayer FromKeyframe(Replay);
+        FromKeyframe.Start(Game);
+        FromKeyframe.SeekToAction(Game, TargetActionIndex, &Keyframes);
+        const double FromKeyframeSeconds = FPlatformTime::Seconds() - StartTime;
+
+        UE_LOG(LogMinesweeperReplay, Log, TEXT("Seek to action %d of %d: %.3f ms from the start, %.3f ms from a keyframe"),
+            FromKeyframe.GetActionIndex(), Keyframes.GetNumActions(), FromStartSeconds * 1000.0, FromKeyframeSeconds * 1000.0);
+    }));
@@ -0,0 +1,346 @@
+// MinesweeperSessionHost.cpp
+#include "MinesweeperSessionHost.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperSessions, Log, All);
+
+// Commands and their actions waiting for a worker. The worker swaps both arrays out under the
+// lock and runs them outside it, so their allocations go back and forth instead of being freed.
+struct FMinesweeperSessionHost::FWorker
+{
+    FCriticalSection Lock;
+    TArray<FCommand> Commands;
+    TArray<FMinesweeperGame::FAction> Actions;
+    bool bStopping = false;
+
+    FEvent* WakeEvent = nullptr;
+    TFuture<void> Thread;
+};
+
+FMinesweeperSessionHost::FMinesweeperSessionHost(int32 NumWorkers)
+    : NumSlots(0)
+    , NumLiveSessions(0)
+    , NumQueuedCommands(0)
+{
+    NumWorkers = NumWorkers > 0 ? NumWorkers : FPlatformMisc::NumberOfCores();
+    for (int32 Index = 0; Index < NumWorkers; ++Index)
+    {
+        FWorker& Worker = *Workers.Add_GetRef(MakeUnique<FWorker>());
+        Worker.WakeEvent = FPlatformProcess::GetSynchEventFromPool();
+        Worker.Thread = Async(EAsyncExecution::Thread, [this, &Worker]() { RunWorker(Worker); });
+    }
+}
+
+FMinesweeperSessionHost::~FMinesweeperSessionHost()
+{
+    for (TUniquePtr<FWorker>& Worker : Workers)
+    {
+        {
+            FScopeLock ScopeLock(&Worker->Lock);
+            Worker->bStopping = true;
+        }
+        Worker->WakeEvent->Trigger();
+    }
+    for (TUniquePtr<FWorker>& Worker : Workers)
+    {
+        Worker->Thread.Wait();
+        FPlatformProcess::ReturnSynchEventToPool(Worker->WakeEvent);
+    }
+}
+
+int32 FMinesweeperSessionHost::GetSizeClass(int32 Width, int32 Height)
+{
+    const int32 NumChunks = FMath::DivideAndRoundUp(FMath::Max(1, Width) * FMath::Max(1, Height), 1024);
+    int32 SizeClass = 0;
+    while ((1 << SizeClass) < NumChunks && SizeClass < NumSizeClasses - 1)
+    {
+        SizeClass++;
+    }
+    return SizeClass;
+}
+
+FMinesweeperSessionHost::FSessionId FMinesweeperSessionHost::CreateSession(int32 Width, int32 Height, int32 BombCount, int32 Seed)
+{
+    const int32 SizeClass = GetSizeClass(Width, Height);
+
+    uint32 SlotIndex;
+    {
+        FScopeLock ScopeLock(&PoolLock);
+        if (PooledSlots[SizeClass].Num() > 0)
+        {
+            SlotIndex = PooledSlots[SizeClass].Pop(false);
+        }
+        else
+        {
+            SlotIndex = NumSlots.load(std::memory_order_relaxed);
+            if (SlotIndex == uint32(MaxSlabs) * SlabSlots)
+            {
+                return InvalidSession;
+            }
+            if (SlotIndex % SlabSlots == 0)
+            {
+                Slabs[SlotIndex / SlabSlots] = MakeUnique<FSlab>();
+            }
+            NumSlots.store(SlotIndex + 1, std::memory_order_release);
+        }
+        NumLiveSessions++;
+    }
+
+    // The slot is ours until the session is handed to its worker by the first Submit
+    FSlot& Slot = GetSlot(SlotIndex);
+    if (Slot.SizeClass == INDEX_NONE)
+    {
+        Slot.SizeClass = SizeClass;
+        Slot.Game.SetUndoEnabled(false);
+    }
+    Slot.Game.NewGame(Width, Height, BombCount, Seed);
+
+    return (FSessionId(Slot.Generation) << 32) | SlotIndex;
+}
+
+void FMinesweeperSessionHost::Submit(FSessionId Session, TArrayView<const FMinesweeperGame::FAction> Actions, FOnApplied OnApplied)
+{
+    Enqueue(Session, Actions, MoveTemp(OnApplied), false);
+}
+
+void FMinesweeperSessionHost::EndSession(FSessionId Session)
+{
+    Enqueue(Session, TArrayView<const FMinesweeperGame::FAction>(), FOnApplied(), true);
+}
+
+void FMinesweeperSessionHost::Enqueue(FSessionId Session, TArrayView<const FMinesweeperGame::FAction> Actions, FOnApplied&& OnApplied, bool bEndSession)
+{
+    NumQueuedCommands++;
+
+    FWorker& Worker = *Workers[uint32(Session) % uint32(Workers.Num())];
+    {
+        FScopeLock ScopeLock(&Worker.Lock);
+        Worker.Commands.Add(FCommand{ Session, Worker.Actions.Num(), Actions.Num(), bEndSession, MoveTemp(OnApplied) });
+        Worker.Actions.Append(Actions.GetData(), Actions.Num());
+    }
+    Worker.WakeEvent->Trigger();
+}
+
+void FMinesweeperSessionHost::RunWorker(FWorker& Worker)
+{
+    TArray<FCommand> Commands;
+    TArray<FMinesweeperGame::FAction> Actions;
+    for (;;)
+    {
+        bool bStopping;
+        {
+            FScopeLock ScopeLock(&Worker.Lock);
+            Swap(Commands, Worker.Commands);
+            Swap(Actions, Worker.Actions);
+            bStopping = Worker.bStopping;
+        }
+
+        if (Commands.Num() == 0)
+        {
+            if (bStopping)
+            {
+                return;
+            }
+            Worker.WakeEvent->Wait();
+            continue;
+        }
+
+        for (FCommand& Command : Commands)
+        {
+            // Only this worker runs a slot's sessions, so the generation cannot change under us
+            const uint32 SlotIndex = uint32(Command.Session);
+            FSlot* Slot = SlotIndex < NumSlots.load(std::memory_order_acquire) ? &GetSlot(SlotIndex) : nullptr;
+            if (Slot != nullptr && Slot->Generation != uint32(Command.Session >> 32))
+            {
+                Slot = nullptr;
+            }
+
+            int32 NumApplied = 0;
+            if (Slot != nullptr && Command.NumActions > 0)
+            {
+                NumApplied = Slot->Game.ApplyActions(MakeArrayView(Actions.GetData() + Command.FirstAction, Command.NumActions));
+            }
+            if (Command.OnApplied)
+            {
+                Command.OnApplied(Command.Session, Slot != nullptr ? &Slot->Game : nullptr, NumApplied);
+            }
+
+            if (Slot != nullptr && Command.bEndSession)
+            {
+                // Generation 0 is never handed out, so InvalidSession never matches a slot
+                Slot->Generation = Slot->Generation == MAX_uint32 ? 1 : Slot->Generation + 1;
+
+                FScopeLock ScopeLock(&PoolLock);
+                PooledSlots[Slot->SizeClass].Add(SlotIndex);
+                NumLiveSessions--;
+            }
+            NumQueuedCommands--;
+        }
+        Commands.Reset();
+        Actions.Reset();
+    }
+}
+
+void FMinesweeperSessionHost::Flush() const
+{
+    while (NumQueuedCommands > 0)
+    {
+        FPlatformProcess::Sleep(0.0001f);
+    }
+}
+
+FMinesweeperSessionHost::FStats FMinesweeperSessionHost::GetStats() const
+{
+    FScopeLock ScopeLock(&PoolLock);
+
+    FStats Stats;
+    Stats.LiveSessions = NumLiveSessions;
+    Stats.Slots = int32(NumSlots.load());
+    Stats.SlabBytes = int64(FMath::DivideAndRoundUp(Stats.Slots, SlabSlots)) * sizeof(FSlab);
+    for (int32 SlotIndex = 0; SlotIndex < Stats.Slots; ++SlotIndex)
+    {
+        const FMinesweeperGame& Game = GetSlot(SlotIndex).Game;
+        Stats.BoardBytes += Game.GetBoardAllocatedSize() + Game.GetHistoryAllocatedSize();
+        Stats.ScratchBytes += Game.GetScratchAllocatedSize();
+    }
+    for (const TArray<uint32>& Pool : PooledSlots)
+    {
+        Stats.SlabBytes += Pool.GetAllocatedSize();
+    }
+    return Stats;
+}
+
+// A bot that plays its session with random reveals until the game ends
+struct FMinesweeperSessionBenchmarkBot
+{
+    FMinesweeperSessionHost* Host = nullptr;
+    std::atomic<int32>* FinishedBots = nullptr;
+    FRandomStream Random;
+    int32 Moves = 0;
+
+    static constexpr int32 MaxMoves = 2000;
+
+    void OnApplied(FMinesweeperSessionHost::FSessionId Session, const FMinesweeperGame* Game, int32 /*NumApplied*/)
+    {
+        Moves++;
+        if (Game == nullptr || Game->IsGameOver() || Game->IsGameWon() || Moves >= MaxMoves)
+        {
+            (*FinishedBots)++;
+            return;
+        }
+
+        // Look for a hidden tile a few times before settling for any
+        FMinesweeperGame::FAction Action;
+        for (int32 Attempt = 0; Attempt < 8; ++Attempt)
+        {
+            Action.X = Random.RandHelper(Game->GetWidth());
+            Action.Y = Random.RandHelper(Game->GetHeight());
+            if (Game->GetTile(Action.X, Action.Y).State == FMinesweeperGame::ETileState::Hidden)
+            {
+                break;
+            }
+        }
+        Play(Session, Action);
+    }
+
+    void Play(FMinesweeperSessionHost::FSessionId Session, const FMinesweeperGame::FAction& Action)
+    {
+        Host->Submit(Session, MakeArrayView(&Action, 1), [this](FMinesweeperSessionHost::FSessionId InSession, const FMinesweeperGame* Game, int32 NumApplied)
+        {
+            OnApplied(InSession, Game, NumApplied);
+        });
+    }
+};
+
+static FAutoConsoleCommand SessionBenchmarkCommand(
+    TEXT("Minesweeper.Bench.Sessions"),
+    TEXT("Host many small games at once, each played to the end by a random bot, and report per-session memory and how long creating a session takes, first on new slots and then on pooled ones. Usage: Minesweeper.Bench.Sessions [Sessions=10000] [Width=30] [Height=16] [Bombs=99] [Workers=cores]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 NumSessions = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 1000000) : 10000;
+        const int32 Width = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 2, 1024) : 30;
+        const int32 Height = Args.Num() > 2 ? FMath::Clamp(FCString::Atoi(*Args[2]), 2, 1024) : 16;
+        const int32 Bombs = Args.Num() > 3 ? FMath::Clamp(FCString::Atoi(*Args[3]), 1, Width * Height - 1) : FMath::Min(99, Width * Height - 1);
+        const int32 NumWorkers = Args.Num() > 4 ? FMath::Max(0, FCString::Atoi(*Args[4])) : 0;
+
+        FMinesweeperSessionHost Host(NumWorkers);
+        TArray<FMinesweeperSessionHost::FSessionId> Sessions;
+        TArray<double> CreateSeconds;
+        Sessions.SetNum(NumSessions);
+        CreateSeconds.SetNum(NumSessions);
+
+        auto CreateAll = [&](int32 FirstSeed)
+        {
+            for (int32 Index = 0; Index < NumSessions; ++Index)
+            {
+                const double Start = FPlatformTime::Seconds();
+                Sessions[Index] = Host.CreateSession(Width, Height, Bombs, FirstSeed + Index);
+                CreateSeconds[Index] = FPlatformTime::Seconds() - Start;
+            }
+
+            double Total = 0.0;
+            for (double Seconds : CreateSeconds)
+            {
+                Total += Seconds;
+            }
+            CreateSeconds.Sort();
+            return FString::Printf(TEXT("mean %.2f us, p50 %.2f us, p99 %.2f us, max %.2f us"), Total * 1e6 / NumSessions,
+                CreateSeconds[NumSessions / 2] * 1e6, CreateSeconds[NumSessions * 99 / 100] * 1e6, CreateSeconds.Last() * 1e6);
+        };
+
+        auto PlayAll = [&]()
+        {
+            std::atomic<int32> FinishedBots(0);
+            TArray<FMinesweeperSessionBenchmarkBot> Bots;
+            Bots.SetNum(NumSessions);
+
+            const double Start = FPlatformTime::Seconds();
+            for (int32 Index = 0; Index < NumSessions; ++Index)
+            {
+                FMinesweeperSessionBenchmarkBot& Bot = Bots[Index];
+                Bot.Host = &Host;
+                Bot.FinishedBots = &FinishedBots;
+                Bot.Random.Initialize(Index);
+                Bot.Play(Sessions[Index], FMinesweeperGame::FAction{ FMinesweeperGame::EActionType::Reveal, Width / 2, Height / 2 });
+            }
+            Host.Flush();
+            const double Seconds = FPlatformTime::Seconds() - Start;
+
+            int64 Moves = 0;
+            for (const FMinesweeperSessionBenchmarkBot& Bot : Bots)
+            {
+                Moves += Bot.Moves;
+            }
+            return FString::Printf(TEXT("%d games to the end, %lld moves in %.2f s (%.0f moves/s)"), FinishedBots.load(), (long long)Moves, Seconds, Moves / Seconds);
+        };
+
+        auto EndAll = [&]()
+        {
+            for (FMinesweeperSessionHost::FSessionId Session : Sessions)
+            {
+                Host.EndSession(Session);
+            }
+            Host.Flush();
+        };
+
+        UE_LOG(LogMinesweeperSessions, Log, TEXT("%d sessions of %dx%d with %d bombs on %d workers"), NumSessions, Width, Height, Bombs, Host.GetNumWorkers());
+        for (int32 Round = 0; Round < 2; ++Round)
+        {
+            const FString Creation = CreateAll(Round * NumSessions);
+            const FString Play = PlayAll();
+            const FMinesweeperSessionHost::FStats Stats = Host.GetStats();
+            const int64 TotalBytes = Stats.SlabBytes + Stats.BoardBytes + Stats.ScratchBytes;
+
+            UE_LOG(LogMinesweeperSessions, Log, TEXT("%s slots: create %s"), Round == 0 ? TEXT("New") : TEXT("Pooled"), *Creation);
+            UE_LOG(LogMinesweeperSessions, Log, TEXT("  %s"), *Play);
+            UE_LOG(LogMinesweeperSessions, Log, TEXT("  %d live sessions in %d slots: %.2f MB, %lld bytes per session (slot %lld, board %lld, scratch %lld)"),
+                Stats.LiveSessions, Stats.Slots, TotalBytes / (1024.0 * 1024.0), (long long)(TotalBytes / Stats.LiveSessions),
+                (long long)(Stats.SlabBytes / Stats.LiveSessions), (long long)(Stats.BoardBytes / Stats.LiveSessions), (long long)(Stats.ScratchBytes / Stats.LiveSessions));
+            EndAll();
+        }
+    }));
@@ -0,0 +1,236 @@
+// MinesweeperSharedGame.cpp
+#include "MinesweeperSharedGame.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperSharedGame, Log, All);
+
+FMinesweeperSharedGame::FMinesweeperSharedGame(int32 InMaxBatchActions)
+    : MaxBatchActions(FMath::Max(1, InMaxBatchActions))
+{
+    // No player gets to take back a move the others have built on
+    Game.SetUndoEnabled(false);
+}
+
+FMinesweeperSharedGame::~FMinesweeperSharedGame() = default;
+
+int32 FMinesweeperSharedGame::AddPlayer()
+{
+    PlayerDeltas.Add(MakeUnique<TQueue<FMergedDeltaPtr, EQueueMode::Spsc>>());
+    return PlayerDeltas.Num() - 1;
+}
+
+void FMinesweeperSharedGame::Submit(int32 PlayerId, const FMinesweeperGame::FAction& Action)
+{
+    PendingActions.Enqueue(FPlayerAction{ PlayerId, Action });
+}
+
+bool FMinesweeperSharedGame::PollDelta(int32 PlayerId, FMergedDeltaPtr& OutDelta)
+{
+    return PlayerId >= 0 && PlayerId < PlayerDeltas.Num() && PlayerDeltas[PlayerId]->Dequeue(OutDelta);
+}
+
+int32 FMinesweeperSharedGame::ApplyPending()
+{
+    Batch.Reset();
+    FPlayerAction PlayerAction;
+    while (Batch.Num() < MaxBatchActions && PendingActions.Dequeue(PlayerAction))
+    {
+        Batch.Add(PlayerAction);
+    }
+    if (Batch.Num() == 0)
+    {
+        return 0;
+    }
+
+    // Sorting by tile, then by position in the batch, lines up the actions on each tile behind
+    // the first one submitted
+    TileKeys.Reset();
+    Dropped.Init(false, Batch.Num());
+    for (int32 Index = 0; Index < Batch.Num(); ++Index)
+    {
+        const FMinesweeperGame::FAction& Action = Batch[Index].Action;
+        if (Game.IsValidCoordinate(Action.X, Action.Y))
+        {
+            TileKeys.Add((uint64(Action.Y * Game.GetWidth() + Action.X) << 32) | uint32(Index));
+        }
+        else
+        {
+            // ApplyActions would reject the whole batch for it
+            Dropped[Index] = true;
+            Stats.Rejected++;
+        }
+    }
+    TileKeys.Sort();
+    for (int32 Key = 1; Key < TileKeys.Num(); ++Key)
+    {
+        if ((TileKeys[Key] >> 32) == (TileKeys[Key - 1] >> 32))
+        {
+            Dropped[uint32(TileKeys[Key])] = true;
+            Stats.Conflicts++;
+        }
+    }
+
+    const TSharedRef<FMergedDelta, ESPMode::ThreadSafe> Delta = MakeShared<FMergedDelta, ESPMode::ThreadSafe>();
+    Actions.Reset();
+    for (int32 Index = 0; Index < Batch.Num(); ++Index)
+    {
+        if (!Dropped[Index])
+        {
+            Actions.Add(Batch[Index].Action);
+            Delta->Accepted.Add(Batch[Index]);
+        }
+    }
+
+    const int32 NumApplied = Actions.Num() > 0 ? Game.ApplyActions(Actions, &Delta->RevealedTiles, &Delta->FlaggedTiles) : 0;
+    Delta->StateVersion = Game.GetStateVersion();
+    Delta->bGameOver = Game.IsGameOver();
+    Delta->bGameWon = Game.IsGameWon();
+
+    Stats.Batches++;
+    Stats.Actions += Batch.Num();
+    Stats.Applied += NumApplied;
+    Stats.NoOps += Actions.Num() - NumApplied;
+
+    // Every player shares the one delta
+    const FMergedDeltaPtr SharedDelta = Delta;
+    for (TUniquePtr<TQueue<FMergedDeltaPtr, EQueueMode::Spsc>>& Deltas : PlayerDeltas)
+    {
+        Deltas->Enqueue(SharedDelta);
+    }
+    return Batch.Num();
+}
+
+static FAutoConsoleCommand SharedGameBenchmarkCommand(
+    TEXT("Minesweeper.Bench.SharedGame"),
+    TEXT("Have many producer threads play one shared board as fast as they can, each also reading its merged deltas, and report the applier's throughput in actions taken and in actions that changed the board. This is a best-case load, not a contended random one: producers read where the mines are from recent read snapshots and never click one. Every round opens the centre of the same board, then producers pick hidden tiles from recent read snapshots, flagging mines and revealing the rest; a quarter of their picks fall in a small patch in the middle to force conflicts. Won rounds restart on the same board. Usage: Minesweeper.Bench.SharedGame [Producers=32] [ActionsPerProducer=50000] [Side=256]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 NumProducers = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 256) : 32;
+        const int32 ActionsPerProducer = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 50000;
+        const int32 Side = Args.Num() > 2 ? FMath::Clamp(FCString::Atoi(*Args[2]), 16, 4096) : 256;
+        const int32 Bombs = Side * Side / 8;
+
+        FMinesweeperSharedGame Shared;
+        Shared.GetGame().NewGame(Side, Side, Bombs, 1);
+        Shared.GetGame().RevealTile(Side / 2, Side / 2);
+        const TSharedRef<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> Source = Shared.GetGame().GetReadSnapshotSource();
+        TArray<int64> DeltasSeen;
+        DeltasSeen.SetNumZeroed(NumProducers);
+        for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+        {
+            Shared.AddPlayer();
+        }
+
+        auto PollDeltas = [&Shared, &DeltasSeen](int32 PlayerId)
+        {
+            FMinesweeperSharedGame::FMergedDeltaPtr Delta;
+            while (Shared.PollDelta(PlayerId, Delta))
+            {
+                DeltasSeen[PlayerId]++;
+            }
+        };
+
+        std::atomic<int32> FinishedProducers(0);
+        TArray<TFuture<void>> Producers;
+        for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+        {
+            Producers.Add(Async(EAsyncExecution::Thread, [&, Source, Producer]()
+            {
+                FRandomStream Random(Producer);
+                const int32 HotSide = FMath::Min(16, Side);
+                TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> View;
+                for (int32 Index = 0; Index < ActionsPerProducer; ++Index)
+                {
+                    // Play like a player who can see the mines: pick a tile that still looks
+                    // hidden on a recent snapshot, flag it if it is a mine and reveal it if not.
+                    // Snapshots lag behind the batches, so some picks still conflict or do nothing.
+                    if ((Index & 7) == 0)
+                    {
+                        View = Source->GetLatest();
+                    }
+
+                    FMinesweeperGame::FAction Action;
+                    bool bFound = false;
+                    for (int32 Attempt = 0; Attempt < 8 && !bFound; ++Attempt)
+                    {
+                        if (Random.FRand() < 0.25f)
+                        {
+                            Action.X = (Side - HotSide) / 2 + Random.RandHelper(HotSide);
+                            Action.Y = (Side - HotSide) / 2 + Random.RandHelper(HotSide);
+                        }
+                        else
+                        {
+                            Action.X = Random.RandHelper(Side);
+                            Action.Y = Random.RandHelper(Side);
+                        }
+                        const FMinesweeperGame::FTile Tile = View->GetTile(Action.X, Action.Y);
+                        bFound = Tile.State == FMinesweeperGame::ETileState::Hidden && !Tile.bIsFlagged;
+                        Action.Type = Tile.bIsBomb ? FMinesweeperGame::EActionType::Flag : FMinesweeperGame::EActionType::Reveal;
+                    }
+                    if (bFound)
+                    {
+                        Shared.Submit(Producer, Action);
+                    }
+
+                    if ((Index & 255) == 255)
+                    {
+                        PollDeltas(Producer);
+                    }
+                }
+                FinishedProducers++;
+            }));
+        }
+
+        // The applier runs here, restarting the board whenever a round ends. Every round replays
+        // the same seed from the same first click, so the mines on older snapshots stay put.
+        int32 Rounds = 1;
+        int32 IdleLoops = 0;
+        const double Start = FPlatformTime::Seconds();
+        for (;;)
+        {
+            const bool bProducersDone = FinishedProducers == NumProducers;
+            if (Shared.ApplyPending() == 0)
+            {
+                if (bProducersDone)
+                {
+                    break;
+                }
+                IdleLoops++;
+                FPlatformProcess::Sleep(0.0f);
+                continue;
+            }
+
+            FMinesweeperGame& Game = Shared.GetGame();
+            if (Game.IsGameOver() || Game.IsGameWon())
+            {
+                Game.NewGame(Side, Side, Bombs, 1);
+                Game.RevealTile(Side / 2, Side / 2);
+                Rounds++;
+            }
+        }
+        const double Seconds = FPlatformTime::Seconds() - Start;
+
+        int32 PlayersMissingDeltas = 0;
+        for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+        {
+            Producers[Producer].Wait();
+            PollDeltas(Producer);
+            PlayersMissingDeltas += DeltasSeen[Producer] != int64(Shared.GetStats().Batches);
+        }
+
+        // Conflicts, rejects and no-ops are taken from the queue but change nothing, so applied
+        // actions are reported on their own
+        const FMinesweeperSharedGame::FStats& Stats = Shared.GetStats();
+        const double AppliedPerSecond = Stats.Applied / Seconds;
+        UE_LOG(LogMinesweeperSharedGame, Log, TEXT("%d producers on a %dx%d board: %llu actions taken in %.2f s, %.0f actions/s, over %d rounds"),
+            NumProducers, Side, Side, (unsigned long long)Stats.Actions, Seconds, Stats.Actions / Seconds, Rounds);
+        UE_LOG(LogMinesweeperSharedGame, Log, TEXT("  %llu changed the board: %.0f applied actions/s"),
+            (unsigned long long)Stats.Applied, AppliedPerSecond);
+        UE_LOG(LogMinesweeperSharedGame, Log, TEXT("  %llu batches of %.1f actions on average, %d idle polls; %llu conflicts, %llu no-ops, %llu rejected; %d players missed deltas"),
+            (unsigned long long)Stats.Batches, double(Stats.Actions) / FMath::Max<uint64>(1, Stats.Batches), IdleLoops,
+            (unsigned long long)Stats.Conflicts, (unsigned long long)Stats.NoOps, (unsigned long long)Stats.Rejected, PlayersMissingDeltas);
+    }));
@@ -0,0 +1,382 @@
+// MinesweeperSnapshot.cpp
+#include "MinesweeperSnapshot.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperSnapshot, Log, All);
+
+namespace MinesweeperSnapshot
+{
+    FName GetFormatName(FMinesweeperSnapshot::ECompression Compression)
+    {
+        switch (Compression)
+        {
+            case FMinesweeperSnapshot::ECompression::LZ4: return NAME_LZ4;
+            case FMinesweeperSnapshot::ECompression::Oodle: return NAME_Oodle;
+            default: return NAME_None;
+        }
+    }
+}
+
+bool FMinesweeperSnapshot::Save(const FMinesweeperGame& Game, const FString& Filename, ECompression Compression)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Filename));
+
+    TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*Filename));
+    if (!FileHandle)
+    {
+        UE_LOG(LogMinesweeperSnapshot, Error, TEXT("Could not open %s for writing"), *Filename);
+        return false;
+    }
+
+    return Write(Game, Compression, [&FileHandle](const void* Bytes, int64 NumBytes)
+    {
+        return FileHandle->Write(static_cast<const uint8*>(Bytes), NumBytes);
+    });
+}
+
+bool FMinesweeperSnapshot::Load(FMinesweeperGame& Game, const FString& Filename)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    // Snapshots are read through 32-bit views, as they are written
+    const int64 FileSize = PlatformFile.FileSize(*Filename);
+    if (FileSize > MAX_int32)
+    {
+        UE_LOG(LogMinesweeperSnapshot, Error, TEXT("%s is %lld bytes; snapshots over 2 GB cannot be loaded"), *Filename, (long long)FileSize);
+        return false;
+    }
+
+    // Map the file and read the chunks straight out of the mapping
+    TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*Filename));
+    if (MappedFile)
+    {
+        TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion(0, FileSize));
+        if (MappedRegion)
+        {
+            return LoadFromMemory(Game, MakeArrayView(MappedRegion->GetMappedPtr(), int32(MappedRegion->GetMappedSize())));
+        }
+    }
+
+    // Platforms without memory mapping fall back to a plain read
+    TArray<uint8> FileData;
+    if (!FFileHelper::LoadFileToArray(FileData, *Filename))
+    {
+        UE_LOG(LogMinesweeperSnapshot, Error, TEXT("Could not read %s"), *Filename);
+        return false;
+    }
+
+    return LoadFromMemory(Game, FileData);
+}
+
+void FMinesweeperSnapshot::SaveToMemory(const FMinesweeperGame& Game, TArray<uint8>& OutData, ECompression Compression)
+{
+    OutData.Reset();
+    Write(Game, Compression, [&OutData](const void* Bytes, int64 NumBytes)
+    {
+        OutData.Append(static_cast<const uint8*>(Bytes), int32(NumBytes));
+        return true;
+    });
+}
+
+bool FMinesweeperSnapshot::LoadFromMemory(FMinesweeperGame& Game, TArrayView<const uint8> Data)
+{
+    FHeader Header;
+    if (Data.Num() < int32(sizeof(FHeader)))
+    {
+        return false;
+    }
+    FMemory::Memcpy(&Header, Data.GetData(), sizeof(FHeader));
+
+    // Validate before touching the game
+    const int64 NumTiles = int64(Header.Width) * int64(Header.Height);
+    if (Header.Magic != Magic
+        || Header.Version != CurrentVersion
+        || Header.Compression > uint8(ECompression::Oodle)
+        || Header.Width < 1 || Header.Height < 1 || NumTiles > MAX_int32
+        || Header.BombCount < 0 || Header.BombCount >= NumTiles
+        || Header.NumBlocks < 0)
+    {
+        UE_LOG(LogMinesweeperSnapshot, Error, TEXT("Not a valid minesweeper snapshot"));
+        return false;
+    }
+
+    Game.Width = Header.Width;
+    Game.Height = Header.Height;
+    Game.BombCount = Header.BombCount;
+    Game.Seed = Header.Seed;
+    Game.MoveCount = Header.MoveCount;
+    Game.RevealedTiles = Header.RevealedTiles;
+    Game.FlagCount = Header.FlagCount;
+    Game.bGameOver = (Header.Flags & EHeaderFlags::GameOver) != 0;
+    Game.bGameWon = (Header.Flags & EHeaderFlags::GameWon) != 0;
+    Game.Layout = (Header.Flags & EHeaderFlags::TiledLayout) != 0 ? FMinesweeperGame::EBoardLayout::Tiled : FMinesweeperGame::EBoardLayout::RowMajor;
+
+    // A snapshot of a paged board loads back fully into memory
+    Game.ResetChunks();
+
+    TArray<FBlock> Blocks;
+    GatherBlocks(Game, Blocks);
+
+    bool bValid = true;
+    int64 Offset = sizeof(FHeader);
+
+    if (Header.Compression == uint8(ECompression::None))
+    {
+        // Uncompressed chunks are copied whole
+        const int64 DataSize = int64(Game.Chunks.Num()) * sizeof(FMinesweeperGame::FChunk);
+        bValid = Offset + DataSize <= Data.Num();
+
+        if (bValid)
+        {
+            AllocateChunks(Game);
+            ParallelFor(Blocks.Num(), [&](int32 BlockIndex)
+            {
+                const FBlock& Block = Blocks[BlockIndex];
+                CopyBlockIn(Game, Block, Data.GetData() + Offset + int64(Block.FirstChunk) * sizeof(FMinesweeperGame::FChunk));
+            });
+        }
+    }
+    else if (Header.NumBlocks == Blocks.Num() && Offset + int64(Blocks.Num()) * 4 <= Data.Num())
+    {
+        // Locate every compressed block from the table, then decompress them in parallel
+        TArray<int64> BlockOffsets;
+        TArray<int32> BlockSizes;
+        BlockOffsets.SetNumUninitialized(Blocks.Num());
+        BlockSizes.SetNumUninitialized(Blocks.Num());
+        FMemory::Memcpy(BlockSizes.GetData(), Data.GetData() + Offset, Blocks.Num() * sizeof(uint32));
+        Offset += Blocks.Num() * sizeof(uint32);
+
+        for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+        {
+            BlockOffsets[BlockIndex] = Offset;
+            Offset += BlockSizes[BlockIndex];
+            bValid &= BlockSizes[BlockIndex] > 0 && BlockSizes[BlockIndex] <= Blocks[BlockIndex].Size;
+        }
+        bValid &= Offset <= Data.Num();
+
+        if (bValid)
+        {
+            const FName FormatName = MinesweeperSnapshot::GetFormatName(ECompression(Header.Compression));
+            std::atomic<bool> bDecompressed(true);
+
+            AllocateChunks(Game);
+            ParallelFor(Blocks.Num(), [&](int32 BlockIndex)
+            {
+                const FBlock& Block = Blocks[BlockIndex];
+                const uint8* Source = Data.GetData() + BlockOffsets[BlockIndex];
+
+                // Blocks that did not shrink are stored raw
+                if (BlockSizes[BlockIndex] == Block.Size)
+                {
+                    CopyBlockIn(Game, Block, Source);
+                    return;
+                }
+
+                TArray<uint8> Uncompressed;
+                Uncompressed.SetNumUninitialized(Block.Size);
+                if (FCompression::UncompressMemory(FormatName, Uncompressed.GetData(), Block.Size, Source, BlockSizes[BlockIndex]))
+                {
+                    CopyBlockIn(Game, Block, Uncompressed.GetData());
+                }
+                else
+                {
+                    bDecompressed = false;
+                }
+            });
+
+            bValid = bDecompressed;
+        }
+    }
+    else
+    {
+        bValid = false;
+    }
+
+    if (!bValid)
+    {
+        UE_LOG(LogMinesweeperSnapshot, Error, TEXT("Minesweeper snapshot is truncated or corrupt"));
+
+        // Readers keep following the game through its read snapshot source
+        TSharedPtr<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> ReadSnapshots = MoveTemp(Game.ReadSnapshots);
+        const uint64 StateVersion = Game.StateVersion;
+        Game = FMinesweeperGame();
+        Game.ReadSnapshots = MoveTemp(ReadSnapshots);
+        Game.StateVersion = StateVersion;
+    }
+
+    Game.PublishReadSnapshot();
+    return bValid;
+}
+
+bool FMinesweeperSnapshot::Write(const FMinesweeperGame& Game, ECompression Compression, TFunctionRef<bool(const void*, int64)> WriteBytes)
+{
+    TArray<FBlock> Blocks;
+    GatherBlocks(Game, Blocks);
+
+    FHeader Header;
+    FMemory::Memzero(&Header, sizeof(FHeader));
+    Header.Magic = Magic;
+    Header.Version = CurrentVersion;
+    Header.Compression = uint8(Compression);
+    Header.Flags = (Game.bGameOver ? EHeaderFlags::GameOver : 0) | (Game.bGameWon ? EHeaderFlags::GameWon : 0)
+        | (Game.Layout == FMinesweeperGame::EBoardLayout::Tiled ? EHeaderFlags::TiledLayout : 0);
+    Header.Width = Game.Width;
+    Header.Height = Game.Height;
+    Header.BombCount = Game.BombCount;
+    Header.Seed = Game.Seed;
+    Header.MoveCount = Game.MoveCount;
+    Header.RevealedTiles = Game.RevealedTiles;
+    Header.FlagCount = Game.FlagCount;
+    Header.NumBlocks = Compression == ECompression::None ? 0 : Blocks.Num();
+
+    if (!WriteBytes(&Header, sizeof(FHeader)))
+    {
+        return false;
+    }
+
+    if (Compression == ECompression::None)
+    {
+        // Chunks go out exactly as they are in memory, a block at a time
+        TArray<uint8> BlockData;
+        for (const FBlock& Block : Blocks)
+        {
+            BlockData.SetNumUninitialized(Block.Size, false);
+            CopyBlockOut(Game, Block, BlockData.GetData());
+            if (!WriteBytes(BlockData.GetData(), Block.Size))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Compress blocks independently so both directions run in parallel
+    const FName FormatName = MinesweeperSnapshot::GetFormatName(Compression);
+    TArray<TArray<uint8>> CompressedBlocks;
+    TArray<uint32> BlockSizes;
+    CompressedBlocks.SetNum(Blocks.Num());
+    BlockSizes.SetNumUninitialized(Blocks.Num());
+
+    ParallelFor(Blocks.Num(), [&](int32 BlockIndex)
+    {
+        const FBlock& Block = Blocks[BlockIndex];
+        TArray<uint8> BlockData;
+        BlockData.SetNumUninitialized(Block.Size);
+        CopyBlockOut(Game, Block, BlockData.GetData());
+        const uint8* Source = BlockData.GetData();
+        TArray<uint8>& Compressed = CompressedBlocks[BlockIndex];
+
+        int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, Block.Size);
+        Compressed.SetNumUninitialized(CompressedSize);
+
+        // Keep the block raw unless compression actually saves space
+        if (!FCompression::CompressMemory(FormatName, Compressed.GetData(), CompressedSize, Source, Block.Size) || CompressedSize >= Block.Size)
+        {
+            Compressed.SetNumUninitialized(Block.Size);
+            FMemory::Memcpy(Compressed.GetData(), Source, Block.Size);
+            CompressedSize = Block.Size;
+        }
+
+        Compressed.SetNum(CompressedSize);
+        BlockSizes[BlockIndex] = CompressedSize;
+    }, Game.IsPaged() ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None); // Paging in is not thread safe
+
+    if (!WriteBytes(BlockSizes.GetData(), BlockSizes.Num() * sizeof(uint32)))
+    {
+        return false;
+    }
+
+    for (const TArray<uint8>& Compressed : CompressedBlocks)
+    {
+        if (!WriteBytes(Compressed.GetData(), Compressed.Num()))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FMinesweeperSnapshot::GatherBlocks(const FMinesweeperGame& Game, TArray<FBlock>& OutBlocks)
+{
+    const int32 ChunksPerBlock = BlockSize / int32(sizeof(FMinesweeperGame::FChunk));
+
+    OutBlocks.Reset();
+    for (int32 FirstChunk = 0; FirstChunk < Game.Chunks.Num(); FirstChunk += ChunksPerBlock)
+    {
+        const int32 NumChunks = FMath::Min(ChunksPerBlock, Game.Chunks.Num() - FirstChunk);
+        OutBlocks.Add({ FirstChunk, NumChunks, NumChunks * int32(sizeof(FMinesweeperGame::FChunk)) });
+    }
+}
+
+void FMinesweeperSnapshot::CopyBlockOut(const FMinesweeperGame& Game, const FBlock& Block, uint8* Destination)
+{
+    for (int32 Index = 0; Index < Block.NumChunks; ++Index)
+    {
+        FMemory::Memcpy(Destination + Index * sizeof(FMinesweeperGame::FChunk), &Game.GetChunk((Block.FirstChunk + Index) << FMinesweeperGame::ChunkShift), sizeof(FMinesweeperGame::FChunk));
+    }
+}
+
+void FMinesweeperSnapshot::AllocateChunks(FMinesweeperGame& Game)
+{
+    // The spares are not thread safe, so every chunk is taken here before the workers copy in
+    for (FMinesweeperGame::FChunkPtr& Chunk : Game.Chunks)
+    {
+        Chunk = Game.AllocateChunk();
+    }
+}
+
+void FMinesweeperSnapshot::CopyBlockIn(FMinesweeperGame& Game, const FBlock& Block, const uint8* Source)
+{
+    for (int32 Index = 0; Index < Block.NumChunks; ++Index)
+    {
+        FMemory::Memcpy(Game.Chunks[Block.FirstChunk + Index].Get(), Source + Index * sizeof(FMinesweeperGame::FChunk), sizeof(FMinesweeperGame::FChunk));
+    }
+}
+
+static FAutoConsoleCommand SnapshotBenchmarkCommand(
+    TEXT("Minesweeper.Bench.Snapshot"),
+    TEXT("Time saving and loading a snapshot of a large board. Usage: Minesweeper.Bench.Snapshot [NumTiles=100000000] [None|LZ4|Oodle]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 NumTiles = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000000;
+        const int32 Side = FMath::Max(1, FMath::FloorToInt(FMath::Sqrt(float(NumTiles))));
+
+        FMinesweeperSnapshot::ECompression Compression = FMinesweeperSnapshot::ECompression::None;
+        if (Args.Num() > 1 && Args[1] == TEXT("LZ4"))
+        {
+            Compression = FMinesweeperSnapshot::ECompression::LZ4;
+        }
+        else if (Args.Num() > 1 && Args[1] == TEXT("Oodle"))
+        {
+            Compression = FMinesweeperSnapshot::ECompression::Oodle;
+        }
+
+        FMinesweeperGame Game;
+        Game.NewGame(Side, Side, Side * Side / 6, 1);
+        Game.RevealTile(Side / 2, Side / 2);
+
+        const FString Filename = FPaths::ProjectSavedDir() / TEXT("Minesweeper") / TEXT("Benchmark.snapshot");
+
+        const double SaveStart = FPlatformTime::Seconds();
+        const bool bSaved = FMinesweeperSnapshot::Save(Game, Filename, Compression);
+        const double LoadStart = FPlatformTime::Seconds();
+        FMinesweeperGame LoadedGame;
+        const bool bLoaded = bSaved && FMinesweeperSnapshot::Load(LoadedGame, Filename);
+        const double LoadEnd = FPlatformTime::Seconds();
+
+        UE_LOG(LogMinesweeperSnapshot, Log, TEXT("Snapshot of %dx%d board: save %.1f ms, load %.1f ms, %s"),
+            Side, Side, (LoadStart - SaveStart) * 1000.0, (LoadEnd - LoadStart) * 1000.0,
+            bLoaded ? TEXT("OK") : TEXT("FAILED"));
+
+        FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*Filename);
+    }));
@@ -0,0 +1,421 @@
+// MinesweeperSolver.cpp
+#include "MinesweeperSolver.h"
+#include "Math/UnrealMathUtility.h"
+
+void FMinesweeperSolver::MakeView(const FMinesweeperGame& Game, FBoardView& OutView)
+{
+    OutView.Width = Game.GetWidth();
+    OutView.Height = Game.GetHeight();
+    OutView.BombCount = Game.GetBombCount();
+    OutView.Tiles.SetNumUninitialized(OutView.Width * OutView.Height);
+
+    for (int32 Y = 0; Y < OutView.Height; ++Y)
+    {
+        for (int32 X = 0; X < OutView.Width; ++X)
+        {
+            const FMinesweeperGame::FTile& Tile = Game.GetTile(X, Y);
+            int8& ViewTile = OutView.Tiles[Y * OutView.Width + X];
+
+            if (Tile.State == FMinesweeperGame::ETileState::Hidden)
+            {
+                ViewTile = HiddenTile;
+            }
+            else if (Tile.bIsBomb)
+            {
+                ViewTile = MineTile;
+            }
+            else
+            {
+                ViewTile = static_cast<int8>(Tile.AdjacentBombs);
+            }
+        }
+    }
+}
+
+bool FMinesweeperSolver::Solve(FBoardView& View, TArray<int32>& OutSafeTiles)
+{
+    const int32 NumTiles = View.Width * View.Height;
+    SafeTiles.Init(false, NumTiles);
+    QueuedTiles.Init(false, NumTiles);
+    ConstraintQueue.Reset();
+    OutSafeTiles.Reset();
+
+    // Every revealed number is a constraint on its hidden neighbours
+    for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+    {
+        if (View.Tiles[TileIndex] > 0)
+        {
+            QueuedTiles[TileIndex] = true;
+            ConstraintQueue.Add(TileIndex);
+        }
+    }
+
+    // Cheap rules first; fall back to the more expensive ones only when they stall
+    while (!IsCancelled()
+        && (ApplySinglePointRule(View, OutSafeTiles)
+            || ApplySubsetRule(View, OutSafeTiles)
+            || ApplyMineCountRule(View, OutSafeTiles)))
+    {
+    }
+
+    return OutSafeTiles.Num() > 0;
+}
+
+int32 FMinesweeperSolver::FindLowestRiskTile(const FBoardView& View, float* OutRisk) const
+{
+    const int32 NumTiles = View.Width * View.Height;
+
+    // Frontier tiles take the highest local mine density of the numbers around them
+    TArray<float> Risk;
+    Risk.Init(-1.0f, NumTiles);
+
+    int32 KnownMines = 0;
+    for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+    {
+        if (IsCancelled())
+        {
+            return INDEX_NONE;
+        }
+
+        const int8 Value = View.Tiles[TileIndex];
+        if (Value == MineTile)
+        {
+            KnownMines++;
+            continue;
+        }
+        if (Value <= 0)
+        {
+            continue;
+        }
+
+        const int32 X = TileIndex % View.Width;
+        const int32 Y = TileIndex / View.Width;
+        int32 NumHidden = 0;
+        int32 NumMines = 0;
+
+        for (int32 DY = -1; DY <= 1; ++DY)
+        {
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                const int32 CheckX = X + DX;
+                const int32 CheckY = Y + DY;
+                if (CheckX >= 0 && CheckX < View.Width && CheckY >= 0 && CheckY < View.Height)
+                {
+                    const int8 CheckValue = View.Tiles[CheckY * View.Width + CheckX];
+                    NumHidden += CheckValue == HiddenTile ? 1 : 0;
+                    NumMines += CheckValue == MineTile ? 1 : 0;
+                }
+            }
+        }
+
+        if (NumHidden == 0)
+        {
+            continue;
+        }
+
+        const float LocalRisk = FMath::Clamp(float(Value - NumMines) / float(NumHidden), 0.0f, 1.0f);
+        for (int32 DY = -1; DY <= 1; ++DY)
+        {
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                const int32 CheckX = X + DX;
+                const int32 CheckY = Y + DY;
+                if (CheckX >= 0 && CheckX < View.Width && CheckY >= 0 && CheckY < View.Height)
+                {
+                    const int32 CheckIndex = CheckY * View.Width + CheckX;
+                    if (View.Tiles[CheckIndex] == HiddenTile)
+                    {
+                        Risk[CheckIndex] = FMath::Max(Risk[CheckIndex], LocalRisk);
+                    }
+                }
+            }
+        }
+    }
+
+    // Tiles away from the frontier share whatever mines the frontier is not expected to hold
+    float FrontierMines = 0.0f;
+    int32 NumInterior = 0;
+    for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+    {
+        if (View.Tiles[TileIndex] == HiddenTile)
+        {
+            if (Risk[TileIndex] >= 0.0f)
+            {
+                FrontierMines += Risk[TileIndex];
+            }
+            else
+            {
+                NumInterior++;
+            }
+        }
+    }
+
+    const float InteriorRisk = NumInterior > 0
+        ? FMath::Clamp((float(View.BombCount - KnownMines) - FrontierMines) / float(NumInterior), 0.0f, 1.0f)
+        : 1.0f;
+
+    int32 BestTile = INDEX_NONE;
+    float BestRisk = 2.0f;
+    for (int32 TileIndex = 0; TileIndex < NumTiles; ++TileIndex)
+    {
+        if (View.Tiles[TileIndex] == HiddenTile)
+        {
+            const float TileRisk = Risk[TileIndex] >= 0.0f ? Risk[TileIndex] : InteriorRisk;
+            if (TileRisk < BestRisk)
+            {
+                BestRisk = TileRisk;
+                BestTile = TileIndex;
+            }
+        }
+    }
+
+    if (OutRisk)
+    {
+        *OutRisk = BestTile != INDEX_NONE ? BestRisk : 0.0f;
+    }
+
+    return BestTile;
+}
+
+bool FMinesweeperSolver::ApplySinglePointRule(FBoardView& View, TArray<int32>& OutSafeTiles)
+{
+    bool bChanged = false;
+
+    while (ConstraintQueue.Num() > 0 && !IsCancelled())
+    {
+        const int32 TileIndex = ConstraintQueue.Pop();
+        QueuedTiles[TileIndex] = false;
+
+        int32 Neighbors[8];
+        int32 RemainingMines = 0;
+        const int32 NumUnknown = GetUnknownNeighbors(View, TileIndex, Neighbors, RemainingMines);
+
+        if (NumUnknown == 0)
+        {
+            continue;
+        }
+
+        // All mines accounted for - the rest is safe
+        if (RemainingMines == 0)
+        {
+            for (int32 i = 0; i < NumUnknown; ++i)
+            {
+                MarkSafe(View, Neighbors[i], OutSafeTiles);
+            }
+            bChanged = true;
+        }
+        // Every unknown neighbour must be a mine
+        else if (RemainingMines == NumUnknown)
+        {
+            for (int32 i = 0; i < NumUnknown; ++i)
+            {
+                MarkMine(View, Neighbors[i]);
+            }
+            bChanged = true;
+        }
+    }
+
+    return bChanged;
+}
+
+bool FMinesweeperSolver::ApplySubsetRule(FBoardView& View, TArray<int32>& OutSafeTiles)
+{
+    for (int32 TileIndexA = 0; TileIndexA < View.Tiles.Num() && !IsCancelled(); ++TileIndexA)
+    {
+        if (View.Tiles[TileIndexA] <= 0)
+        {
+            continue;
+        }
+
+        int32 NeighborsA[8];
+        int32 RemainingA = 0;
+        const int32 NumUnknownA = GetUnknownNeighbors(View, TileIndexA, NeighborsA, RemainingA);
+        if (NumUnknownA == 0)
+        {
+            continue;
+        }
+
+        // Only numbers within two tiles can share unknown neighbours
+        const int32 AX = TileIndexA % View.Width;
+        const int32 AY = TileIndexA / View.Width;
+        for (int32 BY = FMath::Max(0, AY - 2); BY <= FMath::Min(View.Height - 1, AY + 2); ++BY)
+        {
+            for (int32 BX = FMath::Max(0, AX - 2); BX <= FMath::Min(View.Width - 1, AX + 2); ++BX)
+            {
+                const int32 TileIndexB = BY * View.Width + BX;
+                if (TileIndexB == TileIndexA || View.Tiles[TileIndexB] <= 0)
+                {
+                    continue;
+                }
+
+                int32 NeighborsB[8];
+                int32 RemainingB = 0;
+                const int32 NumUnknownB = GetUnknownNeighbors(View, TileIndexB, NeighborsB, RemainingB);
+                if (NumUnknownB <= NumUnknownA)
+                {
+                    continue;
+                }
+
+                // Is every unknown of A also an unknown of B? Then the rest of B holds the difference.
+                int32 Difference[8];
+                int32 NumDifference = 0;
+                int32 NumShared = 0;
+                for (int32 i = 0; i < NumUnknownB; ++i)
+                {
+                    bool bShared = false;
+                    for (int32 j = 0; j < NumUnknownA; ++j)
+                    {
+                        bShared |= NeighborsB[i] == NeighborsA[j];
+                    }
+
+                    if (bShared)
+                    {
+                        NumShared++;
+                    }
+                    else
+                    {
+                        Difference[NumDifference++] = NeighborsB[i];
+                    }
+                }
+
+                if (NumShared != NumUnknownA)
+                {
+                    continue;
+                }
+
+                const int32 DifferenceMines = RemainingB - RemainingA;
+                if (DifferenceMines == 0)
+                {
+                    for (int32 i = 0; i < NumDifference; ++i)
+                    {
+                        MarkSafe(View, Difference[i], OutSafeTiles);
+                    }
+                    return true;
+                }
+                if (DifferenceMines == NumDifference)
+                {
+                    for (int32 i = 0; i < NumDifference; ++i)
+                    {
+                        MarkMine(View, Difference[i]);
+                    }
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool FMinesweeperSolver::ApplyMineCountRule(FBoardView& View, TArray<int32>& OutSafeTiles)
+{
+    int32 NumUnknown = 0;
+    int32 KnownMines = 0;
+    for (int32 TileIndex = 0; TileIndex < View.Tiles.Num(); ++TileIndex)
+    {
+        NumUnknown += IsUnknown(View, TileIndex) ? 1 : 0;
+        KnownMines += View.Tiles[TileIndex] == MineTile ? 1 : 0;
+    }
+
+    const int32 RemainingMines = View.BombCount - KnownMines;
+    if (NumUnknown == 0 || (RemainingMines != 0 && RemainingMines != NumUnknown))
+    {
+        return false;
+    }
+
+    for (int32 TileIndex = 0; TileIndex < View.Tiles.Num(); ++TileIndex)
+    {
+        if (IsUnknown(View, TileIndex))
+        {
+            if (RemainingMines == 0)
+            {
+                MarkSafe(View, TileIndex, OutSafeTiles);
+            }
+            else
+            {
+                MarkMine(View, TileIndex);
+            }
+        }
+    }
+
+    return true;
+}
+
+int32 FMinesweeperSolver::GetUnknownNeighbors(const FBoardView& View, int32 TileIndex, int32 (&OutNeighbors)[8], int32& OutRemainingMines) const
+{
+    const int32 X = TileIndex % View.Width;
+    const int32 Y = TileIndex / View.Width;
+    int32 NumUnknown = 0;
+    int32 NumMines = 0;
+
+    for (int32 DY = -1; DY <= 1; ++DY)
+    {
+        for (int32 DX = -1; DX <= 1; ++DX)
+        {
+            const int32 CheckX = X + DX;
+            const int32 CheckY = Y + DY;
+            if ((DX == 0 && DY == 0) || CheckX < 0 || CheckX >= View.Width || CheckY < 0 || CheckY >= View.Height)
+            {
+                continue;
+            }
+
+            const int32 CheckIndex = CheckY * View.Width + CheckX;
+            if (View.Tiles[CheckIndex] == MineTile)
+            {
+                NumMines++;
+            }
+            else if (IsUnknown(View, CheckIndex))
+            {
+                OutNeighbors[NumUnknown++] = CheckIndex;
+            }
+        }
+    }
+
+    OutRemainingMines = View.Tiles[TileIndex] - NumMines;
+    return NumUnknown;
+}
+
+void FMinesweeperSolver::MarkSafe(const FBoardView& View, int32 TileIndex, TArray<int32>& OutSafeTiles)
+{
+    if (!SafeTiles[TileIndex])
+    {
+        SafeTiles[TileIndex] = true;
+        OutSafeTiles.Add(TileIndex);
+        QueueConstraintsAround(View, TileIndex);
+    }
+}
+
+void FMinesweeperSolver::MarkMine(FBoardView& View, int32 TileIndex)
+{
+    if (View.Tiles[TileIndex] != MineTile)
+    {
+        View.Tiles[TileIndex] = MineTile;
+        QueueConstraintsAround(View, TileIndex);
+    }
+}
+
+void FMinesweeperSolver::QueueConstraintsAround(const FBoardView& View, int32 TileIndex)
+{
+    const int32 X = TileIndex % View.Width;
+    const int32 Y = TileIndex / View.Width;
+
+    for (int32 DY = -1; DY <= 1; ++DY)
+    {
+        for (int32 DX = -1; DX <= 1; ++DX)
+        {
+            const int32 CheckX = X + DX;
+            const int32 CheckY = Y + DY;
+            if (CheckX < 0 || CheckX >= View.Width || CheckY < 0 || CheckY >= View.Height)
+            {
+                continue;
+            }
+
+            const int32 CheckIndex = CheckY * View.Width + CheckX;
+            if (View.Tiles[CheckIndex] > 0 && !QueuedTiles[CheckIndex])
+            {
+                QueuedTiles[CheckIndex] = true;
+                ConstraintQueue.Add(CheckIndex);
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+// MinesweeperBatchGame.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperGame.h"
+
+/**
+ * Steps 64 independent boards of the same size at once, for simulations of small boards.
+ * Every plane stores one uint64 per cell where bit N belongs to board N, so adjacency
+ * counting and flood fill advance all boards with word operations instead of 64 passes.
+ * Board N plays exactly like an FMinesweeperGame seeded with the same seed and clicks.
+ */
+class MINESWEEPERCORE_API FMinesweeperBatchGame
+{
+public:
+	static constexpr int32 NumBoards = 64;
+	static constexpr uint64 AllBoards = ~0ull;
+
+	FMinesweeperBatchGame();
+
+	// Initialize all boards; board N uses Seeds[N]
+	void NewGames(int32 InWidth, int32 InHeight, int32 InBombCount, TArrayView<const int32> Seeds);
+
+	// Reveal the same tile on every board selected by BoardMask
+	void RevealTile(int32 X, int32 Y, uint64 BoardMask = AllBoards);
+
+	// Reveal one tile per board; TileIndices[N] is Y * Width + X for board N, or INDEX_NONE to skip it
+	void RevealTiles(TArrayView<const int32> TileIndices);
+
+	// Check if coordinate is valid
+	bool IsValidCoordinate(int32 X, int32 Y) const;
+
+	// Get tile at position on one board, in the same form FMinesweeperGame reports it
+	FMinesweeperGame::FTile GetTile(int32 Board, int32 X, int32 Y) const;
+
+	// Whether the tile holds a bomb on one board, without building the whole tile
+	bool IsBomb(int32 Board, int32 X, int32 Y) const { return IsValidCoordinate(X, Y) && ((BombPlane[Y * Width + X] >> Board) & 1); }
+
+	// Game state, one bit per board
+	uint64 GetGameOverMask() const { return GameOverMask; }
+	uint64 GetGameWonMask() const { return GameWonMask; }
+	uint64 GetFinishedMask() const { return GameOverMask | GameWonMask; }
+	bool IsGameOver(int32 Board) const { return (GameOverMask >> Board) & 1; }
+	bool IsGameWon(int32 Board) const { return (GameWonMask >> Board) & 1; }
+
+	// Grid properties
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+	int32 GetBombCount() const { return BombCount; }
+	int32 GetSeed(int32 Board) const { return Seeds[Board]; }
+
+private:
+	// Place bombs on the boards in BoardMask, keeping SafeIndices[N] clear on board N
+	void PlaceBombs(uint64 BoardMask, const int32* SafeIndices);
+
+	// Bit-sliced adjacency count of all boards at once
+	void CalculateAdjacentBombs();
+
+	// Reveal around every cell queued in PendingCells, for all boards together
+	void FloodFillReveal();
+
+	// Update GameWonMask for the boards in BoardMask
+	void CheckGamesWon(uint64 BoardMask);
+
+	// Bit planes, indexed by Y * Width + X
+	TArray<uint64> BombPlane;
+	TArray<uint64> RevealedPlane;
+	TArray<uint64> ExplodedPlane;
+	TArray<uint64> ZeroPlane;
+	TArray<uint64> CountPlanes[4];
+
+	// Flood fill work list: cells with boards still to expand, and which boards those are
+	TArray<uint64> PendingPlane;
+	TArray<int32> PendingCells;
+
+	// Bomb placement: the shared tile order every board shuffles from, and the swaps that undo a board's shuffle
+	TArray<int32> ShuffleTiles;
+	TArray<int32> ShuffleSwaps;
+
+	int32 Seeds[NumBoards];
+	int32 Width;
+	int32 Height;
+	int32 BombCount;
+	uint64 GeneratedMask;
+	uint64 GameOverMask;
+	uint64 GameWonMask;
+};
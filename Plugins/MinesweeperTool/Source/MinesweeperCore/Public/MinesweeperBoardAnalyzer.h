@@ -0,0 +1,99 @@
+// MinesweeperBoardAnalyzer.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperGame.h"
+#include "MinesweeperSolver.h"
+
+/** Difficulty metrics of one generated board */
+struct FMinesweeperBoardStats
+{
+	int32 Seed = 0;
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 BombCount = 0;
+
+	// Minimum left clicks to clear the board without flags
+	int32 ThreeBV = 0;
+
+	// Connected regions of empty tiles; each one is cleared by a single click
+	int32 Openings = 0;
+
+	// Connected groups of numbers that no opening reveals
+	int32 Islands = 0;
+
+	// Greedy estimate of the minimum clicks when flagging and chording are allowed
+	int32 ZiNi = 0;
+
+	// Times the logic solver got stuck and had to guess before clearing the board
+	int32 SolverGuesses = 0;
+};
+
+/**
+ * Grades boards produced by FMinesweeperGame. Openings, islands and 3BV come from
+ * linear-time labelling; ZiNi and the guess count replay the board with the solver.
+ */
+class MINESWEEPERCORE_API FMinesweeperBoardAnalyzer
+{
+public:
+	// Analyze a game whose bombs are already placed, i.e. after its first click
+	static FMinesweeperBoardStats Analyze(const FMinesweeperGame& Game, int32 FirstClickX, int32 FirstClickY);
+
+	// Generate the board for a seed and first click, then analyze it
+	static FMinesweeperBoardStats AnalyzeSeed(int32 Width, int32 Height, int32 BombCount, int32 Seed, int32 FirstClickX, int32 FirstClickY);
+
+	// Analyze one board per seed, spread across worker threads
+	static void AnalyzeSeeds(int32 Width, int32 Height, int32 BombCount, TArrayView<const int32> Seeds, int32 FirstClickX, int32 FirstClickY, TArray<FMinesweeperBoardStats>& OutStats);
+
+	// Format results as CSV with a header row
+	static FString StatsToCSV(TArrayView<const FMinesweeperBoardStats> Stats);
+
+private:
+	explicit FMinesweeperBoardAnalyzer(const FMinesweeperGame& Game);
+
+	// Label openings and islands and count 3BV
+	void LabelRegions(FMinesweeperBoardStats& OutStats);
+
+	// Greedy flag-and-chord click count
+	int32 EstimateZiNi();
+
+	// Replay the board with the solver from the first click, counting forced guesses
+	int32 CountSolverGuesses(int32 FirstClickIndex);
+
+	// Reveal a tile in the replay, opening its whole region if it is empty
+	void RevealTile(int32 TileIndex);
+
+	// Reset the replay to an untouched board
+	void ResetReplay();
+
+	// 3BV left to clear for chording TileIndex
+	int32 GetChordPremium(int32 TileIndex) const;
+
+	// Recompute the chord premiums around tiles that were revealed or flagged, queueing the ones that changed
+	void UpdateChordPremiums(TArrayView<const int32> Tiles);
+
+	int32 Width;
+	int32 Height;
+	int32 BombCount;
+
+	// Board facts, indexed Y * Width + X
+	TArray<bool> Bombs;
+	TArray<int8> AdjacentBombs;
+	TArray<int32> OpeningIds;
+	TArray<bool> NeedsClick;
+
+	// Replay state
+	TArray<bool> Revealed;
+	TArray<bool> Flagged;
+	TArray<bool> OpeningCleared;
+	TArray<int32> Stack;
+	TArray<int32> ChangedTiles;
+	FMinesweeperSolver::FBoardView View;
+	int32 NumOpenings;
+	int32 NumRevealed;
+
+	// ZiNi: each number's chord premium, and a heap of the positive ones keyed best first.
+	// Entries whose premium has changed since they were pushed are skipped when they come up.
+	TArray<int32> ChordPremiums;
+	TArray<uint64> ChordHeap;
+};
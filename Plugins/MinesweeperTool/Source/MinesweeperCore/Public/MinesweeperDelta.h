@@ -0,0 +1,76 @@
+// MinesweeperDelta.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperGame.h"
+
+// Compact binary deltas of what a player can see, for spectators and external tools. A message
+// takes a viewer from one read snapshot of a game to a later one, so a slow viewer can skip any
+// number of states in one message. A message is an FHeader, little-endian as laid out below,
+// followed by NumRuns runs of
+//
+//   varint Gap, varint Length, ceil(Length / 2) bytes of ETileCode, low nibble first
+//
+// Runs cover changed tiles in row-major order (Y * Width + X). Gap counts the unchanged tiles
+// since the end of the previous run, or since tile 0 for the first. Varints are 7 bits per byte,
+// low bits first, with the top bit set on every byte but the last.
+class MINESWEEPERCORE_API FMinesweeperDelta
+{
+public:
+	static constexpr uint32 Magic = 0x3144534D; // "MSD1"
+	static constexpr uint8 CurrentVersion = 1;
+
+	// A visible tile in one nibble
+	enum class ETileCode : uint8
+	{
+		Hidden = 0,
+		Flagged = 1,
+		Revealed0 = 2, // Revealed0 + N is a revealed tile with N adjacent bombs
+		Mine = 11,
+		Exploded = 12
+	};
+
+	enum class EGameState : uint8
+	{
+		Playing,
+		Lost,
+		Won
+	};
+
+	enum EFlags : uint8
+	{
+		Keyframe = 1
+	};
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Size; // Of the whole message, in bytes
+		uint64 FromVersion; // Game state versions; FromVersion is 0 in a keyframe
+		uint64 ToVersion;
+		int32 Width;
+		int32 Height;
+		int32 RemainingMines;
+		int32 NumRuns;
+		uint8 Version;
+		uint8 Flags;
+		EGameState GameState;
+		uint8 Reserved[5];
+	};
+
+	// Append a message that takes a viewer at From to To, two read snapshots of the same game.
+	// With no From, or a From of a different size, the message is a keyframe. Only chunks that
+	// the two snapshots do not share are compared, so the cost follows what changed.
+	static void Encode(const FMinesweeperGame* From, const FMinesweeperGame& To, TArray<uint8>& OutMessage);
+
+	// Read the header at the start of Data, for framing a stream of messages. Fails if it is
+	// malformed; the message may be longer than Data.
+	static bool ReadHeader(TArrayView<const uint8> Data, FHeader& OutHeader);
+
+	// Apply a whole message to a viewer's board of one ETileCode per tile in row-major order,
+	// resizing it for a keyframe. Fails without a keyframe first or if the message is malformed.
+	static bool Apply(TArrayView<const uint8> Message, TArray<uint8>& InOutTileCodes, FHeader& OutHeader);
+
+	// The code a viewer sees for a tile
+	static ETileCode GetTileCode(const FMinesweeperGame::FTile& Tile);
+};
@@ -0,0 +1,342 @@
+// MinesweeperGame.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class IFileHandle;
+
+class MINESWEEPERCORE_API FMinesweeperGame
+{
+public:
+	enum class ETileState
+	{
+		Hidden,
+		Revealed,
+		Exploded
+	};
+
+	struct FTile
+	{
+		bool bIsBomb = false;
+		int32 AdjacentBombs = 0;
+		ETileState State = ETileState::Hidden;
+
+		// Flags only mark hidden tiles; FlaggedNeighbors counts the flags around this tile
+		bool bIsFlagged = false;
+		int32 FlaggedNeighbors = 0;
+	};
+
+	// A player action, for applying several at once
+	enum class EActionType : uint8
+	{
+		Reveal,
+		Flag,
+		Chord
+	};
+
+	struct FAction
+	{
+		EActionType Type = EActionType::Reveal;
+		int32 X = 0;
+		int32 Y = 0;
+	};
+
+	// Order in which tiles are stored. Tiled makes every chunk a 32x32 square, so a flood
+	// fill or a neighbor lookup stays within a few chunks; RowMajor stores tiles as Y * Width + X.
+	enum class EBoardLayout : uint8
+	{
+		RowMajor,
+		Tiled
+	};
+
+	// Cache counters of a paged board
+	struct FPagingStats
+	{
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+		uint64 PageIns = 0;
+		uint64 PageOuts = 0;
+		int32 ResidentChunks = 0;
+		int32 MaxResidentChunks = 0;
+
+		double GetHitRate() const { return Hits + Misses > 0 ? double(Hits) / double(Hits + Misses) : 1.0; }
+	};
+
+	FMinesweeperGame();
+	FMinesweeperGame(FMinesweeperGame&&);
+	FMinesweeperGame& operator=(FMinesweeperGame&&);
+	~FMinesweeperGame();
+
+	// Initialize a new game with a random seed
+	void NewGame(int32 InWidth, int32 InHeight, int32 InBombCount);
+
+	// Initialize a new game whose board is fully determined by the seed and the first click.
+	// The layout only changes how tiles are stored; both layouts give the same board.
+	void NewGame(int32 InWidth, int32 InHeight, int32 InBombCount, int32 InSeed, EBoardLayout InLayout = EBoardLayout::RowMajor);
+
+	// Initialize a game for boards larger than memory. Chunks live in a page file and at most
+	// MemoryCapBytes of them stay loaded, least recently used first out. Bombs are chosen in one
+	// streaming pass rather than a shuffle of every tile index, so the board is not the one
+	// NewGame makes for the same seed. Paged games keep no undo history.
+	void NewPagedGame(int32 InWidth, int32 InHeight, int32 InBombCount, int32 InSeed, int64 MemoryCapBytes, const FString& PageFilename = FString());
+
+	bool IsPaged() const { return Paging.IsValid(); }
+	FPagingStats GetPagingStats() const;
+	EBoardLayout GetLayout() const { return Layout; }
+    
+	// Reveal a tile at the given coordinates. Flagged tiles are not revealed. With
+	// OutRevealedTiles, the move appends the index (Y * Width + X) of every tile it revealed.
+	bool RevealTile(int32 X, int32 Y, TArray<int32>* OutRevealedTiles = nullptr);
+
+	// Chord a revealed number whose flagged neighbors match it: reveal all its other hidden
+	// neighbors, flooding out from any empty ones in a single pass. A wrong flag loses the game.
+	bool ChordTile(int32 X, int32 Y, TArray<int32>* OutRevealedTiles = nullptr);
+
+	// Flag or unflag a hidden tile. The flag count and the flagged-neighbor counts of the
+	// surrounding tiles are updated here, so reading them never rescans the board.
+	bool ToggleFlag(int32 X, int32 Y);
+
+	// Apply actions in order as one undoable move, for bots and scripts. The whole batch is
+	// rejected if any coordinate is off the board. Openings from consecutive reveals are flooded
+	// in one pass and the win check runs once at the end. Returns how many actions changed the
+	// board; the out arrays receive the combined delta as Y * Width + X indices.
+	int32 ApplyActions(TArrayView<const FAction> Actions, TArray<int32>* OutRevealedTiles = nullptr, TArray<int32>* OutFlaggedTiles = nullptr);
+    
+	// Check if coordinate is valid
+	bool IsValidCoordinate(int32 X, int32 Y) const;
+    
+	// Get tile at position, assembled from the board planes
+	FTile GetTile(int32 X, int32 Y) const;
+    
+	// Game state
+	bool IsGameOver() const { return bGameOver; }
+	bool IsGameWon() const { return bGameWon; }
+    
+	// Grid properties
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+	int32 GetBombCount() const { return BombCount; }
+	int32 GetSeed() const { return Seed; }
+	int32 GetMoveCount() const { return MoveCount; }
+	int32 GetFlagCount() const { return FlagCount; }
+
+	// Mines left for the player to find: the bomb count less the flags placed, right or wrong
+	int32 GetRemainingMines() const { return BombCount - FlagCount; }
+
+	// Unlimited undo and redo of moves. Each step swaps back only the chunks the move
+	// touched, so it costs O(chunks touched) and history memory follows the changed data.
+	bool Undo();
+	bool Redo();
+	bool CanUndo() const { return UndoHistory.Num() > 0; }
+	bool CanRedo() const { return RedoHistory.Num() > 0; }
+	int32 GetUndoDepth() const { return UndoHistory.Num(); }
+
+	// Bots and session hosts that never undo can turn the history off, which drops it; moves
+	// then write their chunks in place instead of keeping the old versions. On by default. With it
+	// off, moves allocate nothing once a game of the same size has been played and restarted.
+	void SetUndoEnabled(bool bEnabled);
+	bool IsUndoEnabled() const { return bUndoEnabled; }
+
+	// Where readers on other threads pick up the game. After every completed move, undo, redo,
+	// new game and snapshot load, the game thread publishes an immutable copy of the game that
+	// shares the board chunks copy-on-write, so publishing costs a pointer per chunk and a reader
+	// never sees a half-applied flood fill. Paged boards publish nothing.
+	// Getting the latest copy is not lock-free: TSharedPtr has no atomic load or exchange, so the
+	// pointer sits behind a reader-writer lock. Readers hold it shared only to copy the pointer
+	// and the game thread holds it only to swap one in, so nobody waits on a move.
+	class MINESWEEPERCORE_API FReadSnapshotSource
+	{
+	public:
+		// The latest published game, or null; safe to call from any thread
+		TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> GetLatest() const;
+
+	private:
+		friend class FMinesweeperGame;
+		mutable FRWLock Lock;
+		TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> Latest;
+	};
+
+	// Start publishing read snapshots. Hold on to the source rather than the game: it outlives
+	// the game, and then keeps the last state it was given.
+	TSharedRef<FReadSnapshotSource, ESPMode::ThreadSafe> GetReadSnapshotSource();
+
+	// Bumped by every change to the game; read snapshots carry the version they were taken at
+	uint64 GetStateVersion() const { return StateVersion; }
+
+	// Memory held by the live board, by the undo/redo history and by the reusable scratch buffers
+	int64 GetBoardAllocatedSize() const;
+	int64 GetHistoryAllocatedSize() const;
+	int64 GetScratchAllocatedSize() const;
+
+	// Pick the bomb tiles for a board, never using SafeIndex. Shared with the batch
+	// engine so both produce the same board for the same seed and first click.
+	static void GenerateBombIndices(int32 InWidth, int32 InHeight, int32 InBombCount, int32 SafeIndex, int32 InSeed, TArray<int32>& OutBombIndices);
+
+	// Same, shuffling in a caller-owned buffer so repeated calls do not allocate
+	static void GenerateBombIndices(int32 InWidth, int32 InHeight, int32 InBombCount, int32 SafeIndex, int32 InSeed, TArray<int32>& OutBombIndices, TArray<int32>& ScratchTileIndices);
+
+private:
+	friend class FMinesweeperSnapshot;
+	friend class FMinesweeperDelta;
+	friend class FMinesweeperLayoutBenchmark;
+
+	// Reset the game state for a new board
+	void StartNewGame(int32 InWidth, int32 InHeight, int32 InBombCount, int32 InSeed, EBoardLayout InLayout);
+
+	// Place bombs randomly on the grid
+	void PlaceBombsRandomly(int32 SafeX, int32 SafeY);
+
+	// Place bombs in a single pass over the chunks in storage order, for paged boards
+	void PlaceBombsStreaming(int32 SafeX, int32 SafeY);
+    
+	// Calculate adjacent bomb counts for all tiles
+	void CalculateAdjacentBombs();
+    
+	// Whether an action would change the board
+	bool CanApplyAction(const FAction& Action) const;
+
+	// The steps of ApplyActions. Reveals only queue their openings in Scratch.FloodQueue.
+	void RevealAt(int32 X, int32 Y, TArray<int32>* OutRevealedTiles);
+	void ToggleFlagAt(int32 X, int32 Y);
+	void ChordAt(int32 X, int32 Y, TArray<int32>* OutRevealedTiles);
+
+	// Reveal outwards from every revealed empty tile in Scratch.FloodQueue, then empty it. A chord's
+	// sources share one queue and the revealed plane is the visited set, so each tile is checked once.
+	void FloodFillReveal(TArray<int32>* OutRevealedTiles);
+
+	// Game over: show every bomb that is still hidden
+	void RevealAllBombs(TArray<int32>* OutRevealedTiles);
+    
+	// Check if the game is won
+	void CheckGameWon();
+
+	// The board is split into fixed-size chunks of consecutive tiles. Each chunk keeps its
+	// tiles as bit-packed planes rather than one struct per tile, so huge boards stay small
+	// and snapshots can store and load the chunks as they are.
+	static constexpr int32 ChunkShift = 10;
+	static constexpr int32 ChunkTiles = 1 << ChunkShift;
+	static constexpr int32 ChunkWords = ChunkTiles / 64;
+
+	struct FChunk
+	{
+		uint64 BombBits[ChunkWords];
+		uint64 RevealedBits[ChunkWords];
+		uint64 ExplodedBits[ChunkWords];
+		uint64 FlaggedBits[ChunkWords];
+
+		// 4-bit adjacent bomb and adjacent flag counts per tile, two tiles per byte
+		uint8 AdjacentCounts[ChunkTiles / 2];
+		uint8 FlaggedCounts[ChunkTiles / 2];
+	};
+
+	// Chunks are shared copy-on-write between the board, the history and the all-zero
+	// chunk a new game starts from; a chunk is copied the first time a move writes to it
+	typedef TSharedPtr<FChunk, ESPMode::ThreadSafe> FChunkPtr;
+	static const FChunkPtr& GetEmptyChunk();
+
+	// Size the board for the current Width, Height and Layout with every chunk empty, and clear the history
+	void ResetChunks();
+
+	// Tiled chunks are TileSide x TileSide squares stored row by row
+	static constexpr int32 TileShift = ChunkShift / 2;
+	static constexpr int32 TileSide = 1 << TileShift;
+
+	// Map between tile coordinates and the storage index the planes are addressed by
+	int32 GetStorageIndex(int32 X, int32 Y) const
+	{
+		return Layout == EBoardLayout::RowMajor
+			? Y * Width + X
+			: ((((Y >> TileShift) * ChunksPerRow) + (X >> TileShift)) << ChunkShift) | ((Y & (TileSide - 1)) << TileShift) | (X & (TileSide - 1));
+	}
+	void GetTileCoordinates(int32 StorageIndex, int32& OutX, int32& OutY) const;
+
+	const FChunk& GetChunk(int32 StorageIndex) const { return Paging.IsValid() ? PageIn(StorageIndex >> ChunkShift) : *Chunks[StorageIndex >> ChunkShift]; }
+	FChunk& GetMutableChunk(int32 StorageIndex);
+
+	// Plane accessors, indexed by storage index
+	static bool GetBit(const uint64* Plane, int32 Index) { return (Plane[(Index >> 6) & (ChunkWords - 1)] >> (Index & 63)) & 1; }
+	static void SetBit(uint64* Plane, int32 Index) { Plane[(Index >> 6) & (ChunkWords - 1)] |= 1ull << (Index & 63); }
+	static void ToggleBit(uint64* Plane, int32 Index) { Plane[(Index >> 6) & (ChunkWords - 1)] ^= 1ull << (Index & 63); }
+	static int32 GetNibble(const uint8* Counts, int32 Index) { return (Counts[(Index & (ChunkTiles - 1)) >> 1] >> ((Index & 1) * 4)) & 0xF; }
+	int32 GetAdjacentCount(int32 Index) const { return GetNibble(GetChunk(Index).AdjacentCounts, Index); }
+
+	// Loaded on demand when the board is paged, hence mutable
+	mutable TArray<FChunkPtr> Chunks;
+	EBoardLayout Layout;
+	int32 ChunksPerRow;
+
+	// Page file, LRU list and counters of a paged board
+	struct FPagingState;
+	TUniquePtr<FPagingState> Paging;
+
+	// Temporary buffers kept between moves and games; once they have grown to the board size,
+	// revealing and restarting reuse them instead of allocating
+	struct FScratchBuffers
+	{
+		TArray<TPair<int32, int32>> FloodQueue;
+		TArray<int32> TileIndices;
+		TArray<int32> BombIndices;
+
+		// Chunk allocations left by the previous game or evicted by the pager
+		TArray<FChunkPtr> SpareChunks;
+	};
+	// Paging in from a const read also takes and returns spares, hence mutable
+	mutable FScratchBuffers Scratch;
+
+	// A chunk allocation with undefined contents, taken from the spares when there are any
+	FChunkPtr AllocateChunk() const;
+
+	// Drop a reference to a chunk, keeping the allocation as a spare if it was the last one
+	void RecycleChunk(FChunkPtr& Chunk) const;
+
+	// Load a chunk of a paged board, evicting the least recently used one if at the cap
+	const FChunk& PageIn(int32 ChunkIndex) const;
+	void EvictOldestChunk() const;
+	void PublishPagingStats() const;
+
+	// Bump the state version and hand a copy of the game to the read snapshot source, if any
+	void PublishReadSnapshot();
+	TSharedPtr<FReadSnapshotSource, ESPMode::ThreadSafe> ReadSnapshots;
+	uint64 StateVersion;
+
+	// One undoable move: the chunks it replaced, paired with the versions on the other
+	// side of it, and the game state from before it. Undo and redo swap both. Most moves
+	// touch only a few chunks, which fit inline without a separate allocation.
+	struct FHistoryEntry
+	{
+		TArray<TPair<int32, FChunkPtr>, TInlineAllocator<4>> Chunks;
+		bool bGameOver;
+		bool bGameWon;
+		int32 RevealedTiles;
+		int32 MoveCount;
+		int32 FlagCount;
+	};
+
+	// Open a history entry for a move; chunks are added to it as the move writes to them
+	void BeginChange();
+	void EndChange();
+	void SwapHistory(FHistoryEntry& Entry);
+
+	// Drop the undo and redo history, keeping its chunk allocations as spares
+	void ClearHistory();
+
+	TArray<FHistoryEntry> UndoHistory;
+	TArray<FHistoryEntry> RedoHistory;
+
+	// The change that last wrote to each chunk, so a chunk joins a history entry only once
+	TArray<uint32> ChunkChangeIds;
+	uint32 ChangeId;
+	bool bRecordingChange;
+	bool bUndoEnabled;
+
+	int32 Width;
+	int32 Height;
+	int32 BombCount;
+	int32 Seed;
+	bool bGameOver;
+	bool bGameWon;
+	int32 RevealedTiles;
+	int32 MoveCount;
+	int32 FlagCount;
+};
\ No newline at end of file
@@ -0,0 +1,52 @@
+// MinesweeperHintService.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperGame.h"
+#include <atomic>
+
+/** A tile worth revealing next, for the game state it was worked out from */
+struct FMinesweeperHint
+{
+	int32 X = INDEX_NONE;
+	int32 Y = INDEX_NONE;
+
+	// True if logic proves the tile safe; otherwise it is only the lowest-risk guess
+	bool bSafe = false;
+	float Risk = 0.0f;
+
+	// FMinesweeperGame::GetStateVersion of the snapshot the hint was computed from
+	uint64 StateVersion = 0;
+};
+
+DECLARE_DELEGATE_OneParam(FOnMinesweeperHintReady, const FMinesweeperHint&);
+
+/**
+ * Runs the solver on a read snapshot in the thread pool and hands the hint back on the game
+ * thread. Only the latest request counts: a new request or Cancel sets the flag the running
+ * solve polls, so superseded work stops early instead of queuing up, and its result is dropped
+ * even if it was already on its way. Requests and cancels are made from the game thread.
+ */
+class MINESWEEPERCORE_API FMinesweeperHintService
+{
+public:
+	~FMinesweeperHintService();
+
+	// Start working out a hint for the snapshot, cancelling the one in flight. OnHintReady runs
+	// on the game thread unless the request is cancelled first; nothing is found if no tile is hidden.
+	void RequestHint(TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> Snapshot, FOnMinesweeperHintReady OnHintReady);
+
+	void Cancel();
+
+	bool IsBusy() const { return ActiveRequest.IsValid(); }
+
+private:
+	struct FRequest
+	{
+		std::atomic<bool> bCancelled { false };
+	};
+
+	static FMinesweeperHint ComputeHint(const FMinesweeperGame& Snapshot, const std::atomic<bool>& bCancelled);
+
+	TSharedPtr<FRequest, ESPMode::ThreadSafe> ActiveRequest;
+};
@@ -0,0 +1,98 @@
+// MinesweeperInfiniteGame.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperGame.h"
+
+/**
+ * Minesweeper on an unbounded board. Mines are not stored: each 64x64 chunk generates them
+ * on demand from a hash of the seed and the chunk coordinate, so a region only exists once a
+ * flood fill or a GetTile call reaches it. Chunks the player has revealed tiles in are kept;
+ * chunks that were only generated to count neighbors are dropped once too many pile up,
+ * since they can always be generated again. Coordinates are 64-bit and the hash treats every
+ * chunk alike, so the board plays the same at (0, 0) and at (10^9, 10^9).
+ */
+class MINESWEEPERCORE_API FMinesweeperInfiniteGame
+{
+public:
+	static constexpr int32 ChunkShift = 6;
+	static constexpr int32 ChunkSize = 1 << ChunkShift;
+
+	// Below about 0.12 the openings can grow without bound
+	static constexpr float DefaultBombDensity = 0.16f;
+	static constexpr float MinBombDensity = 0.12f;
+	static constexpr float MaxBombDensity = 0.9f;
+
+	// Untouched chunks kept around for neighbor counts before they are dropped
+	static constexpr int32 MaxCachedChunks = 1024;
+
+	// Safety net for a single flood fill on the unbounded board: the empty tiles it expands
+	static constexpr int32 MaxFloodTiles = 1 << 22;
+
+	FMinesweeperInfiniteGame();
+
+	// Initialize a new game; the first click and its neighbors are always safe
+	void NewGame(int32 InSeed, float InBombDensity = DefaultBombDensity);
+
+	// Reveal a tile at the given coordinates
+	bool RevealTile(int64 X, int64 Y);
+
+	// Get tile at position, generating its chunk if needed
+	FMinesweeperGame::FTile GetTile(int64 X, int64 Y) const;
+
+	// Game state; there is no win, only the number of tiles revealed so far
+	bool IsGameOver() const { return bGameOver; }
+	int64 GetRevealedTiles() const { return RevealedTiles; }
+	int32 GetMoveCount() const { return MoveCount; }
+	int32 GetSeed() const { return Seed; }
+	float GetBombDensity() const { return BombDensity; }
+
+	// Chunk bookkeeping
+	int32 GetNumTouchedChunks() const { return NumTouchedChunks; }
+	int32 GetNumCachedChunks() const { return Chunks.Num() - NumTouchedChunks; }
+	int32 GetNumGeneratedChunks() const { return NumGeneratedChunks; }
+
+	// Drop every chunk that holds no revealed tiles
+	void EvictUntouchedChunks() const;
+
+private:
+	// One word per row; bit X of a row is the tile at local column X
+	struct FChunk
+	{
+		uint64 BombRows[ChunkSize];
+		uint64 RevealedRows[ChunkSize];
+		bool bTouched;
+	};
+
+	const FChunk& FindOrGenerateChunk(int64 ChunkX, int64 ChunkY) const;
+	FChunk& GetTouchedChunk(int64 X, int64 Y);
+	void GenerateChunk(int64 ChunkX, int64 ChunkY, FChunk& OutChunk) const;
+
+	bool IsBomb(int64 X, int64 Y) const;
+	bool IsRevealed(int64 X, int64 Y) const;
+	int32 CountAdjacentBombs(int64 X, int64 Y) const;
+
+	// Reveal empty tiles breadth first from the zero tiles in FloodFrontier
+	void FloodFillReveal();
+
+	mutable TMap<FInt64Point, TUniquePtr<FChunk>> Chunks;
+	mutable int32 NumGeneratedChunks;
+	int32 NumTouchedChunks;
+
+	int32 Seed;
+	float BombDensity;
+	uint32 BombThreshold;
+
+	// Tiles around the first click are kept free of mines
+	bool bHasFirstClick;
+	FInt64Point FirstClick;
+	FInt64Point ExplodedTile;
+
+	bool bGameOver;
+	int64 RevealedTiles;
+	int32 MoveCount;
+
+	// Revealed empty tiles whose neighbors are still to be revealed. Only a flood fill that hit
+	// MaxFloodTiles leaves any behind.
+	TArray<FInt64Point> FloodFrontier;
+};
@@ -0,0 +1,219 @@
+// MinesweeperReplay.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperGame.h"
+
+class IFileHandle;
+class FMinesweeperReplayKeyframes;
+
+/**
+ * Append-only log of the actions of one game. The header carries the board settings and
+ * seed, so the game can be rebuilt exactly; each action is then two varints: the delta
+ * from the previous tile index (zigzag encoded, low two bits holding the action type)
+ * and the milliseconds since the previous action.
+ */
+class MINESWEEPERCORE_API FMinesweeperReplay
+{
+public:
+	enum class EAction : uint8
+	{
+		Reveal,
+		Flag,
+		Chord
+	};
+
+	struct FAction
+	{
+		EAction Type = EAction::Reveal;
+		int32 TileIndex = 0;
+		uint32 DeltaMilliseconds = 0;
+	};
+
+	// Read position in the action stream
+	struct FCursor
+	{
+		int32 Offset = 0;
+		int32 PreviousTileIndex = 0;
+	};
+
+	static constexpr uint32 Magic = 0x5052534D; // "MSRP"
+	static constexpr uint16 CurrentVersion = 1;
+	static constexpr int32 HeaderSize = 24;
+
+	// Start an empty log for a new game
+	void Reset(int32 InWidth, int32 InHeight, int32 InBombCount, int32 InSeed);
+
+	// Append one action; returns the number of bytes it took
+	int32 AddAction(EAction Type, int32 TileIndex, uint32 DeltaMilliseconds);
+
+	// Decode the action at the cursor and advance it. Returns false at the end of the log,
+	// including when the last action was cut off by an interrupted write.
+	bool ReadAction(FCursor& Cursor, FAction& OutAction) const;
+
+	// Number of complete actions in the log
+	int32 CountActions() const;
+
+	// Whole-file I/O
+	bool Save(const FString& Filename) const;
+	bool Load(const FString& Filename);
+
+	// Header bytes as written at the start of a file
+	void WriteHeader(TArray<uint8>& OutBytes) const;
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+	int32 GetBombCount() const { return BombCount; }
+	int32 GetSeed() const { return Seed; }
+	const TArray<uint8>& GetActionBytes() const { return ActionBytes; }
+
+	// Start a game with the recorded settings
+	void StartGame(FMinesweeperGame& Game) const;
+
+private:
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 BombCount = 0;
+	int32 Seed = 0;
+	int32 PreviousTileIndex = 0;
+	TArray<uint8> ActionBytes;
+};
+
+/**
+ * Records the actions applied to a game, optionally streaming each one to disk as it
+ * happens so the log survives an editor crash.
+ */
+class MINESWEEPERCORE_API FMinesweeperReplayRecorder
+{
+public:
+	FMinesweeperReplayRecorder();
+	~FMinesweeperReplayRecorder();
+
+	// Start recording a freshly started game. With a filename, actions are appended to that file.
+	void Begin(const FMinesweeperGame& Game, const FString& Filename = FString());
+
+	// Record an action that was just applied to the game
+	void RecordAction(FMinesweeperReplay::EAction Type, int32 TileIndex);
+
+	// Stop recording and close the file
+	void End();
+
+	bool IsRecording() const { return bRecording; }
+	const FMinesweeperReplay& GetReplay() const { return Replay; }
+
+private:
+	FMinesweeperReplay Replay;
+	TUniquePtr<IFileHandle> FileHandle;
+	double LastActionTime;
+	bool bRecording;
+};
+
+/**
+ * Applies a replay to a game, either headless at full speed or paced by the recorded
+ * timing for playback in the window.
+ */
+class MINESWEEPERCORE_API FMinesweeperReplayPlayer
+{
+public:
+	struct FRunStats
+	{
+		int32 NumActions = 0;
+		double TotalSeconds = 0.0;
+		double SlowestActionSeconds = 0.0;
+		int32 SlowestActionIndex = INDEX_NONE;
+	};
+
+	explicit FMinesweeperReplayPlayer(const FMinesweeperReplay& InReplay);
+
+	// Restart the game and rewind to the first action
+	void Start(FMinesweeperGame& Game);
+
+	// Apply the next action; returns false when the replay is finished
+	bool Step(FMinesweeperGame& Game);
+
+	// Apply every action recorded up to PlaybackSeconds after the start
+	void AdvanceTo(FMinesweeperGame& Game, double PlaybackSeconds);
+
+	// Jump to any point, forwards or backwards, after Start. With keyframes this restores the
+	// nearest earlier keyframe and applies at most one keyframe interval of actions.
+	void SeekToTime(FMinesweeperGame& Game, double PlaybackSeconds, const FMinesweeperReplayKeyframes* Keyframes = nullptr);
+	void SeekToAction(FMinesweeperGame& Game, int32 TargetActionIndex, const FMinesweeperReplayKeyframes* Keyframes = nullptr);
+
+	bool IsFinished() const;
+	int32 GetActionIndex() const { return ActionIndex; }
+	double GetPlaybackSeconds() const { return LastActionTimeMilliseconds / 1000.0; }
+
+	// Re-run a whole replay at full speed, timing each action
+	static FRunStats RunHeadless(const FMinesweeperReplay& Replay, FMinesweeperGame& Game);
+
+	// Apply one decoded action to a game
+	static bool ApplyAction(FMinesweeperGame& Game, const FMinesweeperReplay::FAction& Action);
+
+private:
+	// Continue from the state stored in a keyframe
+	void Restore(FMinesweeperGame& Game, const FMinesweeperReplayKeyframes& Keyframes, int32 KeyframeIndex);
+	void ReadPendingAction();
+
+	const FMinesweeperReplay& Replay;
+	FMinesweeperReplay::FCursor Cursor;
+	FMinesweeperReplay::FAction PendingAction;
+	bool bHasPendingAction;
+	int32 ActionIndex;
+	uint64 PendingActionTimeMilliseconds;
+	uint64 LastActionTimeMilliseconds;
+};
+
+/**
+ * Board snapshots taken every Interval actions of a replay, kept beside the log in a
+ * .mskeys file. Seeking restores the closest keyframe instead of replaying from move one.
+ */
+class MINESWEEPERCORE_API FMinesweeperReplayKeyframes
+{
+public:
+	struct FKeyframe
+	{
+		// Number of actions applied to the board in the snapshot
+		int32 ActionIndex = 0;
+		// Position of the next action, and the recorded time of the last applied one
+		FMinesweeperReplay::FCursor Cursor;
+		uint64 PlaybackMilliseconds = 0;
+		// FMinesweeperSnapshot data, LZ4 compressed
+		TArray<uint8> Snapshot;
+	};
+
+	static constexpr uint32 Magic = 0x4B52534D; // "MSRK"
+	// Keyframes hold snapshots, so they are rebuilt whenever the snapshot format changes
+	static constexpr uint16 CurrentVersion = 2;
+	static constexpr int32 DefaultInterval = 1000;
+
+	// Play the replay headless once, snapshotting the board every Interval actions
+	void Build(const FMinesweeperReplay& Replay, int32 InInterval = DefaultInterval);
+
+	// Index of the last keyframe at or before the given point, INDEX_NONE if empty
+	int32 FindByAction(int32 ActionIndex) const;
+	int32 FindByTime(uint64 PlaybackMilliseconds) const;
+
+	const FKeyframe& GetKeyframe(int32 Index) const { return Keyframes[Index]; }
+	int32 Num() const { return Keyframes.Num(); }
+	int32 GetInterval() const { return Interval; }
+	int32 GetNumActions() const { return NumActions; }
+	double GetDurationSeconds() const { return DurationMilliseconds / 1000.0; }
+	int64 GetAllocatedSize() const;
+
+	// Keyframes only match the replay they were built from
+	bool IsBuiltFrom(const FMinesweeperReplay& Replay) const;
+
+	bool Save(const FString& Filename) const;
+	bool Load(const FString& Filename);
+
+	// The .mskeys file that goes with a replay file
+	static FString GetKeyframePath(const FString& ReplayFilename);
+
+private:
+	TArray<FKeyframe> Keyframes;
+	int32 Interval = DefaultInterval;
+	int32 NumActions = 0;
+	uint64 DurationMilliseconds = 0;
+	int32 ReplaySeed = 0;
+	int32 ReplayBytes = 0;
+};
@@ -0,0 +1,111 @@
+// MinesweeperSessionHost.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "MinesweeperGame.h"
+#include <atomic>
+
+/**
+ * Hosts many small games in one process, for bot training and server-side validation. Games
+ * live in slots allocated in slabs and are never freed: an ended session's slot goes back to a
+ * pool for its size class, and the next session of that class restarts the same game object,
+ * which writes into the chunks and scratch buffers the last game left. Hosted games keep no
+ * undo history. Each session belongs to one of a fixed set of worker threads, chosen by slot,
+ * so a session's work runs in order without locking the game.
+ */
+class MINESWEEPERCORE_API FMinesweeperSessionHost
+{
+public:
+	// A session's slot in the low 32 bits and the slot's generation in the high 32, so an id
+	// kept after its session ended never reaches the next session in that slot
+	typedef uint64 FSessionId;
+	static constexpr FSessionId InvalidSession = 0;
+
+	// Runs on the session's worker once its actions are applied, with the game, or with null if
+	// the session had ended. It may submit more work or end the session.
+	typedef TFunction<void(FSessionId Session, const FMinesweeperGame* Game, int32 NumApplied)> FOnApplied;
+
+	// Size class N pools games of up to 2^N chunks; larger boards share the last class
+	static constexpr int32 NumSizeClasses = 16;
+	static constexpr int32 SlabSlots = 256;
+	static constexpr int32 MaxSlabs = 4096;
+
+	struct FStats
+	{
+		int32 LiveSessions = 0;
+		int32 Slots = 0;
+
+		// The slabs, with the game object in every slot, and what the games hold beyond that
+		int64 SlabBytes = 0;
+		int64 BoardBytes = 0;
+		int64 ScratchBytes = 0;
+	};
+
+	// With no worker count, one worker per core
+	explicit FMinesweeperSessionHost(int32 NumWorkers = 0);
+
+	// Finishes all queued work first
+	~FMinesweeperSessionHost();
+
+	// Start a game on a pooled slot of its size class. Returns InvalidSession if every slot is
+	// in use. Safe to call from any thread.
+	FSessionId CreateSession(int32 Width, int32 Height, int32 BombCount, int32 Seed);
+
+	// Queue actions to apply to a session as one ApplyActions batch, after anything queued
+	// before. Safe to call from any thread, including from an FOnApplied.
+	void Submit(FSessionId Session, TArrayView<const FMinesweeperGame::FAction> Actions, FOnApplied OnApplied = FOnApplied());
+
+	// Queue the end of a session after its queued actions; its slot then goes back to the pool
+	void EndSession(FSessionId Session);
+
+	// Wait until the workers have run out of queued work
+	void Flush() const;
+
+	int32 GetNumWorkers() const { return Workers.Num(); }
+
+	// Reads every game, so only call it while the host is flushed
+	FStats GetStats() const;
+
+private:
+	struct FSlot
+	{
+		FMinesweeperGame Game;
+		uint32 Generation = 1;
+		int32 SizeClass = INDEX_NONE;
+	};
+
+	struct FSlab
+	{
+		FSlot Slots[SlabSlots];
+	};
+
+	struct FCommand
+	{
+		FSessionId Session;
+		int32 FirstAction;
+		int32 NumActions;
+		bool bEndSession;
+		FOnApplied OnApplied;
+	};
+
+	struct FWorker;
+
+	static int32 GetSizeClass(int32 Width, int32 Height);
+	FSlot& GetSlot(uint32 SlotIndex) const { return Slabs[SlotIndex / SlabSlots]->Slots[SlotIndex % SlabSlots]; }
+
+	void Enqueue(FSessionId Session, TArrayView<const FMinesweeperGame::FAction> Actions, FOnApplied&& OnApplied, bool bEndSession);
+	void RunWorker(FWorker& Worker);
+
+	// Slabs are only ever added, and a slot index below NumSlots always has its slab
+	TUniquePtr<FSlab> Slabs[MaxSlabs];
+	std::atomic<uint32> NumSlots;
+
+	// Guards the pools and slab allocation
+	mutable FCriticalSection PoolLock;
+	TArray<uint32> PooledSlots[NumSizeClasses];
+	int32 NumLiveSessions;
+
+	TArray<TUniquePtr<FWorker>> Workers;
+	std::atomic<int32> NumQueuedCommands;
+};
@@ -0,0 +1,92 @@
+// MinesweeperSharedGame.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "MinesweeperGame.h"
+
+/**
+ * One board that several local players or bots act on at once, for co-op and competitive
+ * modes. Players submit actions from any thread into a lock-free queue. A single applier drains
+ * it in batches, so the game is only ever touched by one thread. Each batch runs as one
+ * ApplyActions call and its merged delta is handed to every player. Within a batch the first
+ * action on a tile wins, and any later action on the same tile is dropped as a conflict. Two
+ * players revealing a tile reveal it once, and two flags on a tile do not cancel out.
+ */
+class MINESWEEPERCORE_API FMinesweeperSharedGame
+{
+public:
+	struct FPlayerAction
+	{
+		int32 PlayerId = INDEX_NONE;
+		FMinesweeperGame::FAction Action;
+	};
+
+	// What one batch did. Accepted lists the actions that survived conflict resolution and were
+	// handed to the game, in order, so a competitive mode can credit the player who set off a
+	// reveal. Not all of them changed the board: some are no-ops, and any action after a losing
+	// click in the same batch is skipped by the game.
+	struct FMergedDelta
+	{
+		uint64 StateVersion = 0;
+		TArray<FPlayerAction> Accepted;
+		TArray<int32> RevealedTiles;
+		TArray<int32> FlaggedTiles;
+		bool bGameOver = false;
+		bool bGameWon = false;
+	};
+	typedef TSharedPtr<const FMergedDelta, ESPMode::ThreadSafe> FMergedDeltaPtr;
+
+	struct FStats
+	{
+		uint64 Batches = 0;
+		uint64 Actions = 0;
+
+		// Reached the game and changed the board
+		uint64 Applied = 0;
+
+		// Dropped for a tile an earlier action in the batch already took, or for being off the board
+		uint64 Conflicts = 0;
+		uint64 Rejected = 0;
+
+		// Reached the game but changed nothing, such as revealing a tile that was already open
+		uint64 NoOps = 0;
+	};
+
+	explicit FMinesweeperSharedGame(int32 InMaxBatchActions = 4096);
+	~FMinesweeperSharedGame();
+
+	// Players join on the applier's thread. Each one gets its own queue of merged deltas.
+	int32 AddPlayer();
+	int32 GetNumPlayers() const { return PlayerDeltas.Num(); }
+
+	// Queue an action for the next batch. Lock-free and safe to call from any thread.
+	void Submit(int32 PlayerId, const FMinesweeperGame::FAction& Action);
+
+	// Take the oldest merged delta the player has not seen yet. Call it from one thread per player.
+	bool PollDelta(int32 PlayerId, FMergedDeltaPtr& OutDelta);
+
+	// Apply up to the batch size of queued actions as one move and hand the merged delta to
+	// every player. Returns how many actions were taken from the queue. Applier's thread only.
+	int32 ApplyPending();
+
+	// The authoritative game, for the applier's thread only: to start rounds or read the board
+	FMinesweeperGame& GetGame() { return Game; }
+	const FStats& GetStats() const { return Stats; }
+
+private:
+	FMinesweeperGame Game;
+	int32 MaxBatchActions;
+
+	TQueue<FPlayerAction, EQueueMode::Mpsc> PendingActions;
+	TArray<TUniquePtr<TQueue<FMergedDeltaPtr, EQueueMode::Spsc>>> PlayerDeltas;
+
+	// Reused by every batch: the actions taken from the queue, their tiles sorted to find
+	// conflicts, which of them are dropped, and the actions that go on to the game
+	TArray<FPlayerAction> Batch;
+	TArray<uint64> TileKeys;
+	TArray<bool> Dropped;
+	TArray<FMinesweeperGame::FAction> Actions;
+
+	FStats Stats;
+};
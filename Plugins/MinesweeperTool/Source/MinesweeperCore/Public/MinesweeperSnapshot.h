@@ -0,0 +1,81 @@
+// MinesweeperSnapshot.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperGame.h"
+
+/**
+ * Versioned binary save format for FMinesweeperGame. The board chunks are written exactly
+ * as the game keeps them, grouped into independently compressed blocks, so saving and
+ * loading copy or decompress whole chunks and never touch individual tiles.
+ */
+class MINESWEEPERCORE_API FMinesweeperSnapshot
+{
+public:
+	enum class ECompression : uint8
+	{
+		None,
+		LZ4,
+		Oodle
+	};
+
+	static constexpr uint32 Magic = 0x5357534D; // "MSWS"
+	static constexpr uint16 CurrentVersion = 3;
+
+	// Uncompressed bytes per compression block; blocks are compressed and loaded in parallel
+	static constexpr int32 BlockSize = 1 << 20;
+
+	// Write the game to a file
+	static bool Save(const FMinesweeperGame& Game, const FString& Filename, ECompression Compression = ECompression::None);
+
+	// Memory-map a snapshot file and load it into the game
+	static bool Load(FMinesweeperGame& Game, const FString& Filename);
+
+	// In-memory variants, for embedding snapshots in other formats
+	static void SaveToMemory(const FMinesweeperGame& Game, TArray<uint8>& OutData, ECompression Compression = ECompression::None);
+	static bool LoadFromMemory(FMinesweeperGame& Game, TArrayView<const uint8> Data);
+
+private:
+	// Fixed-size file header, followed by the block table and the plane data
+	struct FHeader
+	{
+		uint32 Magic;
+		uint16 Version;
+		uint8 Compression;
+		uint8 Flags;
+		int32 Width;
+		int32 Height;
+		int32 BombCount;
+		int32 Seed;
+		int32 MoveCount;
+		int32 RevealedTiles;
+		int32 NumBlocks;
+		int32 FlagCount;
+	};
+
+	enum EHeaderFlags : uint8
+	{
+		GameOver = 1 << 0,
+		GameWon = 1 << 1,
+		TiledLayout = 1 << 2
+	};
+
+	// Serialize through a byte sink, shared by the file and memory writers
+	static bool Write(const FMinesweeperGame& Game, ECompression Compression, TFunctionRef<bool(const void*, int64)> WriteBytes);
+
+	// A run of consecutive chunks, at most BlockSize bytes
+	struct FBlock
+	{
+		int32 FirstChunk;
+		int32 NumChunks;
+		int32 Size;
+	};
+	static void GatherBlocks(const FMinesweeperGame& Game, TArray<FBlock>& OutBlocks);
+
+	// Give every chunk of the game its own allocation, reusing the spares the last game left
+	static void AllocateChunks(FMinesweeperGame& Game);
+
+	// Copy a block's chunks to or from contiguous bytes; reading in writes into allocated chunks
+	static void CopyBlockOut(const FMinesweeperGame& Game, const FBlock& Block, uint8* Destination);
+	static void CopyBlockIn(FMinesweeperGame& Game, const FBlock& Block, const uint8* Source);
+};
@@ -0,0 +1,73 @@
+// MinesweeperSolver.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MinesweeperGame.h"
+#include <atomic>
+
+/**
+ * Logic solver working on what a player can see of a board. It only ever reads the
+ * player's view, never the hidden bombs, so its answers are the ones a human could reach.
+ */
+class MINESWEEPERCORE_API FMinesweeperSolver
+{
+public:
+	// Tile values of a board view besides the revealed adjacent counts 0-8
+	static constexpr int8 HiddenTile = -1;
+	static constexpr int8 MineTile = -2;
+
+	struct FBoardView
+	{
+		int32 Width = 0;
+		int32 Height = 0;
+		int32 BombCount = 0;
+
+		// HiddenTile, MineTile (revealed or deduced) or the revealed adjacent count, indexed Y * Width + X
+		TArray<int8> Tiles;
+	};
+
+	// Build the player's view of a game. Flagged tiles stay HiddenTile, as a flag can be wrong.
+	static void MakeView(const FMinesweeperGame& Game, FBoardView& OutView);
+
+	// Deduce tiles that are certainly safe or certainly mines. Deduced mines are written
+	// back into View as MineTile. Returns false when logic alone cannot make progress.
+	bool Solve(FBoardView& View, TArray<int32>& OutSafeTiles);
+
+	// Estimate the chance of each hidden tile being a mine and return the lowest-risk one,
+	// or INDEX_NONE if nothing is hidden
+	int32 FindLowestRiskTile(const FBoardView& View, float* OutRisk = nullptr) const;
+
+	// Cooperative cancellation for solves running in the background: once the flag is set,
+	// Solve and FindLowestRiskTile return early with incomplete results
+	void SetCancelFlag(const std::atomic<bool>* InCancelFlag) { CancelFlag = InCancelFlag; }
+	bool IsCancelled() const { return CancelFlag && CancelFlag->load(std::memory_order_relaxed); }
+
+private:
+	// Single-point rule over the queued constraint tiles
+	bool ApplySinglePointRule(FBoardView& View, TArray<int32>& OutSafeTiles);
+
+	// Subset rule between constraint tiles up to two tiles apart
+	bool ApplySubsetRule(FBoardView& View, TArray<int32>& OutSafeTiles);
+
+	// Remaining-mine count rule for the whole board
+	bool ApplyMineCountRule(FBoardView& View, TArray<int32>& OutSafeTiles);
+
+	// Gather the undecided hidden neighbours of a revealed tile and the mines it still needs
+	int32 GetUnknownNeighbors(const FBoardView& View, int32 TileIndex, int32 (&OutNeighbors)[8], int32& OutRemainingMines) const;
+
+	void MarkSafe(const FBoardView& View, int32 TileIndex, TArray<int32>& OutSafeTiles);
+	void MarkMine(FBoardView& View, int32 TileIndex);
+	void QueueConstraintsAround(const FBoardView& View, int32 TileIndex);
+
+	bool IsUnknown(const FBoardView& View, int32 TileIndex) const
+	{
+		return View.Tiles[TileIndex] == HiddenTile && !SafeTiles[TileIndex];
+	}
+
+	// Scratch state, reused across calls
+	TArray<bool> SafeTiles;
+	TArray<bool> QueuedTiles;
+	TArray<int32> ConstraintQueue;
+
+	const std::atomic<bool>* CancelFlag = nullptr;
+};
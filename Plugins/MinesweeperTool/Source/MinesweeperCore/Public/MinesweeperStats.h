@@ -0,0 +1,8 @@
+// MinesweeperStats.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// Shown with "stat Minesweeper"
+DECLARE_STATS_GROUP(TEXT("Minesweeper"), STATGROUP_Minesweeper, STATCAT_Advanced);
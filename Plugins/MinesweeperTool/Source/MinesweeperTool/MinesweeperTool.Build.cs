@@ -25,7 +25,7 @@ public class MinesweeperTool : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Core", "Slate", "HTTP","Json","JsonUtilities"
+				"Core", "CoreUObject", "Slate", "HTTP", "HTTPServer", "Json","JsonUtilities", "MinesweeperCore"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -39,10 +39,11 @@ public class MinesweeperTool : ModuleRules
 				"EditorFramework",
 				"UnrealEd",
 				"ToolMenus",
-				"CoreUObject",
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"Sockets",
+				"Networking",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
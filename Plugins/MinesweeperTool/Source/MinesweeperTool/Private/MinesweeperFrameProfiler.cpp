@@ -0,0 +1,131 @@
+// MinesweeperFrameProfiler.cpp
+#include "MinesweeperFrameProfiler.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/SlateRenderer.h"
+#include "HAL/PlatformTime.h"
+
+FMinesweeperFrameProfiler::~FMinesweeperFrameProfiler()
+{
+    End();
+}
+
+void FMinesweeperFrameProfiler::Begin()
+{
+    End();
+
+    FrameSeconds.Reset();
+    DrawSeconds.Reset();
+    PaintSeconds.Reset();
+    PostTickTime = 0.0;
+    LastRenderedTime = 0.0;
+    LastWidgetCount = 0;
+    PeakWidgetCount = 0;
+    StartTime = FPlatformTime::Seconds();
+    bRunning = true;
+
+    // Prepass and paint run between the end of Slate's tick and each window reaching the renderer
+    FSlateApplication& SlateApplication = FSlateApplication::Get();
+    PostTickHandle = SlateApplication.OnPostTick().AddRaw(this, &FMinesweeperFrameProfiler::OnPostTick);
+    if (FSlateRenderer* Renderer = SlateApplication.GetRenderer())
+    {
+        WindowRenderedHandle = Renderer->OnSlateWindowRendered().AddRaw(this, &FMinesweeperFrameProfiler::OnWindowRendered);
+    }
+}
+
+void FMinesweeperFrameProfiler::End()
+{
+    if (!bRunning)
+    {
+        return;
+    }
+
+    bRunning = false;
+    EndTime = FPlatformTime::Seconds();
+
+    if (FSlateApplication::IsInitialized())
+    {
+        FSlateApplication& SlateApplication = FSlateApplication::Get();
+        SlateApplication.OnPostTick().Remove(PostTickHandle);
+        if (FSlateRenderer* Renderer = SlateApplication.GetRenderer())
+        {
+            Renderer->OnSlateWindowRendered().Remove(WindowRenderedHandle);
+        }
+    }
+}
+
+void FMinesweeperFrameProfiler::AddFrame(float DeltaSeconds)
+{
+    // The first delta reaches back to before the run
+    if (bRunning && FPlatformTime::Seconds() - StartTime > DeltaSeconds)
+    {
+        FrameSeconds.Add(DeltaSeconds);
+    }
+}
+
+void FMinesweeperFrameProfiler::AddPaintTime(double Seconds)
+{
+    if (bRunning)
+    {
+        PaintSeconds.Add(float(Seconds));
+    }
+}
+
+void FMinesweeperFrameProfiler::SampleWidgetCount(const TSharedRef<SWidget>& Root)
+{
+    LastWidgetCount = CountWidgets(Root);
+    PeakWidgetCount = FMath::Max(PeakWidgetCount, LastWidgetCount);
+}
+
+int32 FMinesweeperFrameProfiler::CountWidgets(const TSharedRef<SWidget>& Widget)
+{
+    int32 Count = 1;
+    FChildren* Children = Widget->GetChildren();
+    for (int32 Index = 0; Index < Children->Num(); ++Index)
+    {
+        Count += CountWidgets(Children->GetChildAt(Index));
+    }
+    return Count;
+}
+
+void FMinesweeperFrameProfiler::OnPostTick(float DeltaSeconds)
+{
+    // The windows rendered since the last tick close off the previous frame's sample
+    if (PostTickTime > 0.0 && LastRenderedTime > PostTickTime)
+    {
+        DrawSeconds.Add(float(LastRenderedTime - PostTickTime));
+    }
+    PostTickTime = FPlatformTime::Seconds();
+}
+
+void FMinesweeperFrameProfiler::OnWindowRendered(SWindow& Window, void* ViewportRHI)
+{
+    LastRenderedTime = FPlatformTime::Seconds();
+}
+
+FString FMinesweeperFrameProfiler::BuildReport() const
+{
+    auto Summarize = [](const TCHAR* Label, TArray<float> Samples)
+    {
+        if (Samples.Num() == 0)
+        {
+            return FString::Printf(TEXT("%s: no samples\n"), Label);
+        }
+
+        double Total = 0.0;
+        for (float Seconds : Samples)
+        {
+            Total += Seconds;
+        }
+        Samples.Sort();
+        return FString::Printf(TEXT("%s: avg %.2f ms, p95 %.2f ms, p99 %.2f ms\n"), Label, Total * 1000.0 / Samples.Num(),
+            Samples[Samples.Num() * 95 / 100] * 1000.0f, Samples[Samples.Num() * 99 / 100] * 1000.0f);
+    };
+
+    FString Report = FString::Printf(TEXT("%d frames in %.1f s (%.1f fps)\n"), FrameSeconds.Num(), EndTime - StartTime,
+        FrameSeconds.Num() / FMath::Max(EndTime - StartTime, 0.001));
+    Report += Summarize(TEXT("Frame time"), FrameSeconds);
+    Report += Summarize(TEXT("Slate prepass + paint, all windows"), DrawSeconds);
+    Report += Summarize(TEXT("Minesweeper paint"), PaintSeconds);
+    Report += FString::Printf(TEXT("Widgets: %d at the end, %d at peak"), LastWidgetCount, PeakWidgetCount);
+    return Report;
+}
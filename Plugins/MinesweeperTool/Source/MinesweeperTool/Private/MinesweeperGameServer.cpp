@@ -0,0 +1,576 @@
+// MinesweeperGameServer.cpp
+#include "MinesweeperGameServer.h"
+#include "MinesweeperTool.h"
+#include "HttpServerModule.h"
+#include "IHttpRouter.h"
+#include "HttpPath.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "CoreGlobals.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Parse.h"
+#include "Math/RandomStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperServer, Log, All);
+
+typedef TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>> FCondensedJsonWriter;
+typedef TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>> FCondensedJsonWriterFactory;
+
+// Tile values in a delta, matching UMinesweeperScriptGame::GetVisibleBoard
+static constexpr int32 MineValue = -2;
+
+static TSharedPtr<FJsonObject> ParseJson(const TArray<uint8>& Body)
+{
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Body.GetData()), Body.Num());
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get()));
+
+    TSharedPtr<FJsonObject> Object;
+    return FJsonSerializer::Deserialize(Reader, Object) ? Object : nullptr;
+}
+
+static EHttpServerResponseCodes WriteError(EHttpServerResponseCodes Code, const FString& Message, FString& OutJson)
+{
+    const TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&OutJson);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("error"), Message);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+    return Code;
+}
+
+// The listener binds to every interface unless the engine config overrides its port, so add an
+// override for ours unless the project already has one
+static void RestrictListenerToLocalhost(uint32 Port)
+{
+    static const TCHAR* Section = TEXT("HTTPServer.Listeners");
+    TArray<FString> Overrides;
+    GConfig->GetArray(Section, TEXT("ListenerOverrides"), Overrides, GEngineIni);
+
+    for (const FString& Override : Overrides)
+    {
+        uint32 OverridePort = 0;
+        if (FParse::Value(*Override, TEXT("Port="), OverridePort) && OverridePort == Port)
+        {
+            return;
+        }
+    }
+
+    Overrides.Add(FString::Printf(TEXT("(Port=%u,BindAddress=127.0.0.1)"), Port));
+    GConfig->SetArray(Section, TEXT("ListenerOverrides"), Overrides, GEngineIni);
+}
+
+FMinesweeperGameServer::FMinesweeperGameServer(int32 NumShards)
+    : NextSessionId(1)
+    , NumSessions(0)
+    , Port(0)
+{
+    Shards.SetNum(FMath::Max(1, NumShards));
+}
+
+FMinesweeperGameServer::~FMinesweeperGameServer()
+{
+    Stop();
+}
+
+bool FMinesweeperGameServer::Start(uint32 InPort)
+{
+    check(IsInGameThread());
+    if (IsRunning())
+    {
+        return InPort == Port;
+    }
+
+    RestrictListenerToLocalhost(InPort);
+    Router = FHttpServerModule::Get().GetHttpRouter(InPort, /*bFailOnBindFailure*/ true);
+    if (!Router.IsValid())
+    {
+        UE_LOG(LogMinesweeperServer, Error, TEXT("Could not listen on port %u"), InPort);
+        return false;
+    }
+    Port = InPort;
+
+    BindRoute(TEXT("/minesweeper/games"), EHttpServerRequestVerbs::VERB_POST, &FMinesweeperGameServer::HandleCreateGame);
+    BindRoute(TEXT("/minesweeper/games/:id/actions"), EHttpServerRequestVerbs::VERB_POST, &FMinesweeperGameServer::HandleApplyActions);
+    BindRoute(TEXT("/minesweeper/games/:id/delta"), EHttpServerRequestVerbs::VERB_GET, &FMinesweeperGameServer::HandleGetDelta);
+    BindRoute(TEXT("/minesweeper/games/:id"), EHttpServerRequestVerbs::VERB_DELETE, &FMinesweeperGameServer::HandleDeleteGame);
+    FHttpServerModule::Get().StartAllListeners();
+
+    UE_LOG(LogMinesweeperServer, Log, TEXT("Game server listening on http://127.0.0.1:%u/minesweeper with %d shards"), Port, Shards.Num());
+    return true;
+}
+
+void FMinesweeperGameServer::Stop()
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+
+    for (const FHttpRouteHandle& Handle : RouteHandles)
+    {
+        Router->UnbindRoute(Handle);
+    }
+    RouteHandles.Reset();
+    Router.Reset();
+
+    for (FShard& Shard : Shards)
+    {
+        FScopeLock Lock(&Shard.Lock);
+        NumSessions -= Shard.Sessions.Num();
+        Shard.Sessions.Empty();
+    }
+
+    UE_LOG(LogMinesweeperServer, Log, TEXT("Game server on port %u stopped"), Port);
+}
+
+void FMinesweeperGameServer::BindRoute(const TCHAR* Path, EHttpServerRequestVerbs Verb, FRouteHandler Handler)
+{
+    const TWeakPtr<FMinesweeperGameServer, ESPMode::ThreadSafe> WeakServer = AsShared();
+
+    RouteHandles.Add(Router->BindRoute(FHttpPath(Path), Verb, FHttpRequestHandler::CreateLambda(
+        [WeakServer, Handler](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+        {
+            // The listener calls this on the game thread. Parsing and play happen in the pool, in
+            // the same queue for every shard.
+            Async(EAsyncExecution::ThreadPool, [WeakServer, Handler, Request, OnComplete]()
+            {
+                FString Json;
+                EHttpServerResponseCodes Code;
+                if (const TSharedPtr<FMinesweeperGameServer, ESPMode::ThreadSafe> Server = WeakServer.Pin())
+                {
+                    Code = (Server.Get()->*Handler)(Request, Json);
+                }
+                else
+                {
+                    Code = WriteError(EHttpServerResponseCodes::ServiceUnavail, TEXT("The server has stopped"), Json);
+                }
+
+                // Connections are serviced on the game thread, so the response is handed back
+                // there. It is written on the listener's next tick.
+                AsyncTask(ENamedThreads::GameThread, [OnComplete, Code, Json = MoveTemp(Json)]()
+                {
+                    TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(Json, TEXT("application/json"));
+                    Response->Code = Code;
+                    OnComplete(MoveTemp(Response));
+                });
+            });
+            return true;
+        })));
+}
+
+int32 FMinesweeperGameServer::GetSessionId(const FHttpServerRequest& Request)
+{
+    const FString* Id = Request.PathParams.Find(TEXT("id"));
+    return Id && Id->IsNumeric() ? FMath::Max(INDEX_NONE, FCString::Atoi(**Id)) : INDEX_NONE;
+}
+
+EHttpServerResponseCodes FMinesweeperGameServer::HandleCreateGame(const FHttpServerRequest& Request, FString& OutJson)
+{
+    // Every field is optional; an empty body starts an expert game
+    int32 Width = 30;
+    int32 Height = 16;
+    int32 BombCount = 99;
+    int32 Seed = FMath::Rand();
+    if (Request.Body.Num() > 0)
+    {
+        const TSharedPtr<FJsonObject> Body = ParseJson(Request.Body);
+        if (!Body.IsValid())
+        {
+            return WriteError(EHttpServerResponseCodes::BadRequest, TEXT("The body is not a JSON object"), OutJson);
+        }
+        Body->TryGetNumberField(TEXT("width"), Width);
+        Body->TryGetNumberField(TEXT("height"), Height);
+        Body->TryGetNumberField(TEXT("bombs"), BombCount);
+        Body->TryGetNumberField(TEXT("seed"), Seed);
+    }
+
+    if (Width < 1 || Height < 1 || int64(Width) * Height > MaxBoardTiles || BombCount < 0 || BombCount >= Width * Height)
+    {
+        return WriteError(EHttpServerResponseCodes::BadRequest,
+            FString::Printf(TEXT("Boards can have up to %d tiles, with fewer bombs than tiles"), MaxBoardTiles), OutJson);
+    }
+
+    if (NumSessions++ >= MaxSessions)
+    {
+        NumSessions--;
+        return WriteError(EHttpServerResponseCodes::ServiceUnavail,
+            FString::Printf(TEXT("The server already hosts %d games; delete finished ones"), MaxSessions), OutJson);
+    }
+
+    // Set the game up before taking the shard's lock
+    TUniquePtr<FSession> Session = MakeUnique<FSession>();
+    Session->Game.NewGame(Width, Height, BombCount, Seed);
+
+    const int32 SessionId = NextSessionId++;
+    {
+        FShard& Shard = GetShard(SessionId);
+        FScopeLock Lock(&Shard.Lock);
+        Shard.Sessions.Add(SessionId, MoveTemp(Session));
+    }
+
+    const TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&OutJson);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("id"), SessionId);
+    Writer->WriteValue(TEXT("width"), Width);
+    Writer->WriteValue(TEXT("height"), Height);
+    Writer->WriteValue(TEXT("bombs"), BombCount);
+    Writer->WriteValue(TEXT("seed"), Seed);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+    return EHttpServerResponseCodes::Created;
+}
+
+EHttpServerResponseCodes FMinesweeperGameServer::HandleApplyActions(const FHttpServerRequest& Request, FString& OutJson)
+{
+    const int32 SessionId = GetSessionId(Request);
+    if (SessionId == INDEX_NONE)
+    {
+        return WriteError(EHttpServerResponseCodes::NotFound, TEXT("No such game"), OutJson);
+    }
+
+    // Parse the batch before taking the shard's lock
+    const TSharedPtr<FJsonObject> Body = ParseJson(Request.Body);
+    const TArray<TSharedPtr<FJsonValue>>* ActionValues = nullptr;
+    if (!Body.IsValid() || !Body->TryGetArrayField(TEXT("actions"), ActionValues))
+    {
+        return WriteError(EHttpServerResponseCodes::BadRequest, TEXT("Expected {\"actions\": [...]}"), OutJson);
+    }
+    if (ActionValues->Num() > MaxActionsPerRequest)
+    {
+        return WriteError(EHttpServerResponseCodes::BadRequest, FString::Printf(TEXT("At most %d actions per request"), MaxActionsPerRequest), OutJson);
+    }
+
+    TArray<FMinesweeperGame::FAction> Actions;
+    Actions.Reserve(ActionValues->Num());
+    for (const TSharedPtr<FJsonValue>& Value : *ActionValues)
+    {
+        const TSharedPtr<FJsonObject>* ActionObject = nullptr;
+        FString Type;
+        FMinesweeperGame::FAction& Action = Actions.AddDefaulted_GetRef();
+        if (!Value->TryGetObject(ActionObject) || !(*ActionObject)->TryGetStringField(TEXT("type"), Type)
+            || !(*ActionObject)->TryGetNumberField(TEXT("x"), Action.X) || !(*ActionObject)->TryGetNumberField(TEXT("y"), Action.Y))
+        {
+            return WriteError(EHttpServerResponseCodes::BadRequest, TEXT("Actions look like {\"type\": \"reveal\", \"x\": 0, \"y\": 0}"), OutJson);
+        }
+
+        if (Type == TEXT("reveal"))
+        {
+            Action.Type = FMinesweeperGame::EActionType::Reveal;
+        }
+        else if (Type == TEXT("flag"))
+        {
+            Action.Type = FMinesweeperGame::EActionType::Flag;
+        }
+        else if (Type == TEXT("chord"))
+        {
+            Action.Type = FMinesweeperGame::EActionType::Chord;
+        }
+        else
+        {
+            return WriteError(EHttpServerResponseCodes::BadRequest, FString::Printf(TEXT("Unknown action type \"%s\""), *Type), OutJson);
+        }
+    }
+
+    FShard& Shard = GetShard(SessionId);
+    FScopeLock Lock(&Shard.Lock);
+    TUniquePtr<FSession>* Found = Shard.Sessions.Find(SessionId);
+    if (!Found)
+    {
+        return WriteError(EHttpServerResponseCodes::NotFound, TEXT("No such game"), OutJson);
+    }
+
+    // The batch's changes are appended to the session's log, so its delta is the new version
+    FSession& Session = **Found;
+    const int32 PreviousVersion = Session.GetVersion();
+    const int32 NumApplied = Session.Game.ApplyActions(Actions, &Session.RevealedTiles, &Session.FlagTiles);
+    if (NumApplied > 0)
+    {
+        Session.RevealedEnds.Add(Session.RevealedTiles.Num());
+        Session.FlagEnds.Add(Session.FlagTiles.Num());
+    }
+
+    WriteDelta(Session, PreviousVersion, NumApplied, OutJson);
+    return EHttpServerResponseCodes::Ok;
+}
+
+EHttpServerResponseCodes FMinesweeperGameServer::HandleGetDelta(const FHttpServerRequest& Request, FString& OutJson)
+{
+    const int32 SessionId = GetSessionId(Request);
+    const FString* Since = Request.QueryParams.Find(TEXT("since"));
+    const int32 SinceVersion = Since ? FMath::Max(0, FCString::Atoi(**Since)) : 0;
+
+    FShard& Shard = GetShard(FMath::Max(0, SessionId));
+    FScopeLock Lock(&Shard.Lock);
+    const TUniquePtr<FSession>* Found = Shard.Sessions.Find(SessionId);
+    if (!Found)
+    {
+        return WriteError(EHttpServerResponseCodes::NotFound, TEXT("No such game"), OutJson);
+    }
+
+    WriteDelta(**Found, SinceVersion, INDEX_NONE, OutJson);
+    return EHttpServerResponseCodes::Ok;
+}
+
+EHttpServerResponseCodes FMinesweeperGameServer::HandleDeleteGame(const FHttpServerRequest& Request, FString& OutJson)
+{
+    const int32 SessionId = GetSessionId(Request);
+
+    // Free the game after releasing the lock
+    TUniquePtr<FSession> Removed;
+    {
+        FShard& Shard = GetShard(FMath::Max(0, SessionId));
+        FScopeLock Lock(&Shard.Lock);
+        TUniquePtr<FSession>* Found = Shard.Sessions.Find(SessionId);
+        if (!Found)
+        {
+            return WriteError(EHttpServerResponseCodes::NotFound, TEXT("No such game"), OutJson);
+        }
+        Removed = MoveTemp(*Found);
+        Shard.Sessions.Remove(SessionId);
+    }
+    NumSessions--;
+
+    OutJson = TEXT("{}");
+    return EHttpServerResponseCodes::Ok;
+}
+
+void FMinesweeperGameServer::WriteDelta(const FSession& Session, int32 SinceVersion, int32 NumApplied, FString& OutJson)
+{
+    const FMinesweeperGame& Game = Session.Game;
+    const int32 Version = Session.GetVersion();
+    SinceVersion = FMath::Min(SinceVersion, Version);
+    const int32 FirstRevealed = SinceVersion > 0 ? Session.RevealedEnds[SinceVersion - 1] : 0;
+    const int32 FirstFlag = SinceVersion > 0 ? Session.FlagEnds[SinceVersion - 1] : 0;
+
+    const TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&OutJson);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("version"), Version);
+    if (NumApplied != INDEX_NONE)
+    {
+        Writer->WriteValue(TEXT("applied"), NumApplied);
+    }
+
+    Writer->WriteArrayStart(TEXT("revealed"));
+    for (int32 Index = FirstRevealed; Index < Session.RevealedTiles.Num(); ++Index)
+    {
+        Writer->WriteValue(Session.RevealedTiles[Index]);
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteArrayStart(TEXT("values"));
+    for (int32 Index = FirstRevealed; Index < Session.RevealedTiles.Num(); ++Index)
+    {
+        const int32 Tile = Session.RevealedTiles[Index];
+        const FMinesweeperGame::FTile State = Game.GetTile(Tile % Game.GetWidth(), Tile / Game.GetWidth());
+        Writer->WriteValue(State.bIsBomb ? MineValue : int32(State.AdjacentBombs));
+    }
+    Writer->WriteArrayEnd();
+
+    // A tile toggled more than once since the version lands in the list for its current state
+    for (const bool bFlagged : { true, false })
+    {
+        Writer->WriteArrayStart(bFlagged ? TEXT("flagged") : TEXT("unflagged"));
+        for (int32 Index = FirstFlag; Index < Session.FlagTiles.Num(); ++Index)
+        {
+            const int32 Tile = Session.FlagTiles[Index];
+            if (Game.GetTile(Tile % Game.GetWidth(), Tile / Game.GetWidth()).bIsFlagged == bFlagged)
+            {
+                Writer->WriteValue(Tile);
+            }
+        }
+        Writer->WriteArrayEnd();
+    }
+
+    Writer->WriteValue(TEXT("gameOver"), Game.IsGameOver());
+    Writer->WriteValue(TEXT("won"), Game.IsGameWon());
+    Writer->WriteValue(TEXT("remainingMines"), Game.GetRemainingMines());
+    Writer->WriteObjectEnd();
+    Writer->Close();
+}
+
+// Bots that play random reveals against a server over loopback, through the engine's HTTP client,
+// and report the request rate. Everything runs on the game thread from the client's callbacks.
+// Both ends are serviced once per frame, so the report includes the frame rate the run got.
+class FMinesweeperServerBenchmark : public TSharedFromThis<FMinesweeperServerBenchmark>
+{
+public:
+    FMinesweeperServerBenchmark(uint32 Port, int32 InNumRequests)
+        : BaseUrl(FString::Printf(TEXT("http://127.0.0.1:%u/minesweeper/games"), Port))
+        , NumRequests(InNumRequests)
+        , NumSent(0)
+        , NumCompleted(0)
+        , NumFailed(0)
+        , StartTime(FPlatformTime::Seconds())
+        , StartFrame(GFrameCounter)
+        , Random(int32(FPlatformTime::Cycles()))
+    {
+    }
+
+    // Each bot creates an expert game, reveals random tiles, fetches a delta every few moves
+    // and deletes the game once it is over
+    void StartBot()
+    {
+        CreateGame();
+    }
+
+private:
+    void CreateGame()
+    {
+        Send(TEXT("POST"), BaseUrl, TEXT("{\"width\":30,\"height\":16,\"bombs\":99}"), [this](const TSharedPtr<FJsonObject>& Result)
+        {
+            int32 SessionId = INDEX_NONE;
+            if (Result.IsValid() && Result->TryGetNumberField(TEXT("id"), SessionId))
+            {
+                Play(SessionId, 0);
+            }
+            else
+            {
+                CreateGame();
+            }
+        });
+    }
+
+    void Play(int32 SessionId, int32 Move)
+    {
+        const FString GameUrl = FString::Printf(TEXT("%s/%d"), *BaseUrl, SessionId);
+        if (Move % 4 == 3)
+        {
+            Send(TEXT("GET"), GameUrl + TEXT("/delta?since=0"), FString(), [this, SessionId, Move](const TSharedPtr<FJsonObject>&)
+            {
+                Play(SessionId, Move + 1);
+            });
+            return;
+        }
+
+        const FString Body = FString::Printf(TEXT("{\"actions\":[{\"type\":\"reveal\",\"x\":%d,\"y\":%d}]}"), Random.RandHelper(30), Random.RandHelper(16));
+        Send(TEXT("POST"), GameUrl + TEXT("/actions"), Body, [this, SessionId, Move, GameUrl](const TSharedPtr<FJsonObject>& Result)
+        {
+            bool bGameOver = true;
+            if (Result.IsValid())
+            {
+                Result->TryGetBoolField(TEXT("gameOver"), bGameOver);
+            }
+
+            if (!bGameOver)
+            {
+                Play(SessionId, Move + 1);
+                return;
+            }
+
+            Send(TEXT("DELETE"), GameUrl, FString(), [this](const TSharedPtr<FJsonObject>&)
+            {
+                CreateGame();
+            });
+        });
+    }
+
+    void Send(const TCHAR* Verb, const FString& Url, const FString& Body, TFunction<void(const TSharedPtr<FJsonObject>&)> OnResult)
+    {
+        if (NumSent >= NumRequests)
+        {
+            return;
+        }
+        NumSent++;
+
+        const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+        Request->SetVerb(Verb);
+        Request->SetURL(Url);
+        if (!Body.IsEmpty())
+        {
+            Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+            Request->SetContentAsString(Body);
+        }
+
+        // The callbacks hold the benchmark until its last request completes
+        Request->OnProcessRequestComplete().BindLambda([This = AsShared(), OnResult = MoveTemp(OnResult)](FHttpRequestPtr, FHttpResponsePtr Response, bool bSucceeded)
+        {
+            TSharedPtr<FJsonObject> Result;
+            if (bSucceeded && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+            {
+                Result = ParseJson(Response->GetContent());
+            }
+            This->NumFailed += !Result.IsValid();
+            This->NumCompleted++;
+
+            OnResult(Result);
+            if (This->NumCompleted == This->NumRequests)
+            {
+                This->Report();
+            }
+        });
+        Request->ProcessRequest();
+    }
+
+    void Report() const
+    {
+        const double Seconds = FPlatformTime::Seconds() - StartTime;
+        const double RequestsPerSecond = NumCompleted / FMath::Max(Seconds, 1e-6);
+        const double FramesPerSecond = (GFrameCounter - StartFrame) / FMath::Max(Seconds, 1e-6);
+        UE_LOG(LogMinesweeperServer, Log, TEXT("%d requests in %.2f s: %.0f requests/s (target %.0f, %s), %d failed, at %.0f frames/s"),
+            NumCompleted, Seconds, RequestsPerSecond, FMinesweeperGameServer::TargetRequestsPerSecond,
+            RequestsPerSecond >= FMinesweeperGameServer::TargetRequestsPerSecond ? TEXT("met") : TEXT("missed"), NumFailed, FramesPerSecond);
+    }
+
+    const FString BaseUrl;
+    const int32 NumRequests;
+    int32 NumSent;
+    int32 NumCompleted;
+    int32 NumFailed;
+    const double StartTime;
+    const uint64 StartFrame;
+    FRandomStream Random;
+};
+
+static FAutoConsoleCommand ServerStartCommand(
+    TEXT("Minesweeper.Server.Start"),
+    TEXT("Host games for bots over HTTP on 127.0.0.1. Usage: Minesweeper.Server.Start [Port=8790] [Shards=cores]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const uint32 Port = Args.Num() > 0 ? uint32(FMath::Clamp(FCString::Atoi(*Args[0]), 1, 65535)) : FMinesweeperGameServer::DefaultPort;
+        const int32 NumShards = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 256) : FPlatformMisc::NumberOfCores();
+        FMinesweeperToolModule::Get().StartGameServer(Port, NumShards);
+    }));
+
+static FAutoConsoleCommand ServerStopCommand(
+    TEXT("Minesweeper.Server.Stop"),
+    TEXT("Stop hosting games over HTTP. Usage: Minesweeper.Server.Stop"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        FMinesweeperToolModule::Get().StopGameServer();
+    }));
+
+static FAutoConsoleCommand ServerBenchmarkCommand(
+    TEXT("Minesweeper.Server.Bench"),
+    TEXT("Play random games against the game server from many bots at once and report requests per second against the target. Starts the server if it is not running. Usage: Minesweeper.Server.Bench [Bots=64] [Requests=20000]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 NumBots = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 1024) : 64;
+        const int32 NumRequests = Args.Num() > 1 ? FMath::Max(NumBots, FCString::Atoi(*Args[1])) : 20000;
+
+        TSharedPtr<FMinesweeperGameServer, ESPMode::ThreadSafe> Server = FMinesweeperToolModule::Get().GetGameServer();
+        if (!Server.IsValid() || !Server->IsRunning())
+        {
+            if (!FMinesweeperToolModule::Get().StartGameServer(FMinesweeperGameServer::DefaultPort, FPlatformMisc::NumberOfCores()))
+            {
+                return;
+            }
+            Server = FMinesweeperToolModule::Get().GetGameServer();
+        }
+
+        UE_LOG(LogMinesweeperServer, Log, TEXT("%d bots sending %d requests to port %u; keep the editor focused, as background throttling slows the listener"),
+            NumBots, NumRequests, Server->GetPort());
+        const TSharedRef<FMinesweeperServerBenchmark> Benchmark = MakeShared<FMinesweeperServerBenchmark>(Server->GetPort(), NumRequests);
+        for (int32 Bot = 0; Bot < NumBots; ++Bot)
+        {
+            Benchmark->StartBot();
+        }
+    }));
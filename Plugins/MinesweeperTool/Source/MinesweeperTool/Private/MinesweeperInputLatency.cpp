@@ -0,0 +1,181 @@
+// MinesweeperInputLatency.cpp
+#include "MinesweeperInputLatency.h"
+#include "MinesweeperGame.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperLatency, Log, All);
+
+const float FMinesweeperInputLatency::BucketLimits[NumBuckets - 1] = { 1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 33.0f, 66.0f, 100.0f };
+
+FMinesweeperInputLatency& FMinesweeperInputLatency::Get()
+{
+    static FMinesweeperInputLatency Instance;
+    return Instance;
+}
+
+#if MINESWEEPER_INPUT_LATENCY
+void FMinesweeperInputLatency::OnInput(const FMinesweeperGame& Game)
+{
+    InputCycles = FPlatformTime::Cycles64();
+    InputVersion = Game.GetStateVersion();
+    Stage = EStage::Input;
+}
+
+void FMinesweeperInputLatency::OnApplied(const FMinesweeperGame& Game)
+{
+    // Clicks that changed nothing have nothing to paint
+    if (Stage != EStage::Input || Game.GetStateVersion() == InputVersion)
+    {
+        Stage = EStage::Idle;
+        return;
+    }
+
+    AppliedCycles = FPlatformTime::Cycles64();
+    AppliedVersion = Game.GetStateVersion();
+    BoardSize = FIntPoint(Game.GetWidth(), Game.GetHeight());
+    Stage = EStage::Applied;
+}
+
+void FMinesweeperInputLatency::OnPublished()
+{
+    if (Stage == EStage::Applied)
+    {
+        PublishedCycles = FPlatformTime::Cycles64();
+        Stage = EStage::Published;
+    }
+}
+
+void FMinesweeperInputLatency::OnPainted(const FMinesweeperGame& Game)
+{
+    if (Stage != EStage::Published || Game.GetStateVersion() < AppliedVersion)
+    {
+        return;
+    }
+    Stage = EStage::Idle;
+
+    const uint64 PaintedCycles = FPlatformTime::Cycles64();
+    const FSample Sample = {
+        float(FPlatformTime::ToMilliseconds64(AppliedCycles - InputCycles)),
+        float(FPlatformTime::ToMilliseconds64(PublishedCycles - AppliedCycles)),
+        float(FPlatformTime::ToMilliseconds64(PaintedCycles - PublishedCycles))
+    };
+
+    FBoardSamples& Board = Boards.FindOrAdd(BoardSize);
+    if (Board.Samples.Num() < SamplesPerBoard)
+    {
+        Board.Samples.Add(Sample);
+    }
+    else
+    {
+        Board.Samples[Board.NextSample] = Sample;
+    }
+    Board.NextSample = (Board.NextSample + 1) % SamplesPerBoard;
+    Board.TotalClicks++;
+    Revision++;
+}
+#endif
+
+FMinesweeperInputLatency::FSummary FMinesweeperInputLatency::Summarize(const FBoardSamples& Board)
+{
+    FSummary Summary;
+    Summary.Count = Board.Samples.Num();
+    if (Summary.Count == 0)
+    {
+        return Summary;
+    }
+
+    TArray<float> Totals;
+    Totals.Reserve(Summary.Count);
+    for (const FSample& Sample : Board.Samples)
+    {
+        const float Total = Sample.GetTotal();
+        Totals.Add(Total);
+        Summary.Mean.Apply += Sample.Apply / Summary.Count;
+        Summary.Mean.Publish += Sample.Publish / Summary.Count;
+        Summary.Mean.Paint += Sample.Paint / Summary.Count;
+
+        int32 Bucket = 0;
+        while (Bucket < NumBuckets - 1 && Total >= BucketLimits[Bucket])
+        {
+            Bucket++;
+        }
+        Summary.Buckets[Bucket]++;
+    }
+
+    Totals.Sort();
+    Summary.P50 = Totals[Summary.Count / 2];
+    Summary.P95 = Totals[Summary.Count * 95 / 100];
+    Summary.P99 = Totals[Summary.Count * 99 / 100];
+    return Summary;
+}
+
+FString FMinesweeperInputLatency::Describe(int32 Width, int32 Height) const
+{
+    const FBoardSamples* Board = Boards.Find(FIntPoint(Width, Height));
+    if (Board == nullptr)
+    {
+        return FString::Printf(TEXT("Click to paint, %dx%d: no clicks yet"), Width, Height);
+    }
+
+    const FSummary Summary = Summarize(*Board);
+    FString Text = FString::Printf(TEXT("Click to paint, %dx%d, last %d clicks: p50 %.1f ms, p95 %.1f ms, p99 %.1f ms\n"),
+        Width, Height, Summary.Count, Summary.P50, Summary.P95, Summary.P99);
+    Text += FString::Printf(TEXT("Mean: apply %.2f ms, publish %.2f ms, paint %.2f ms\n"), Summary.Mean.Apply, Summary.Mean.Publish, Summary.Mean.Paint);
+
+    // One bar per bucket, scaled to the fullest
+    int32 MaxBucket = 1;
+    for (const int32 Count : Summary.Buckets)
+    {
+        MaxBucket = FMath::Max(MaxBucket, Count);
+    }
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        const FString Label = Bucket < NumBuckets - 1
+            ? FString::Printf(TEXT("<%g ms"), BucketLimits[Bucket])
+            : FString::Printf(TEXT(">=%g ms"), BucketLimits[NumBuckets - 2]);
+        Text += FString::Printf(TEXT("%9s %-20s %d\n"), *Label, *FString::ChrN(Summary.Buckets[Bucket] * 20 / MaxBucket, TEXT('#')), Summary.Buckets[Bucket]);
+    }
+    return Text.LeftChop(1);
+}
+
+bool FMinesweeperInputLatency::DumpCsv(const FString& Filename) const
+{
+    FString Csv = TEXT("Width,Height,TotalClicks,Samples,P50Ms,P95Ms,P99Ms,MeanApplyMs,MeanPublishMs,MeanPaintMs");
+    for (int32 Bucket = 0; Bucket < NumBuckets - 1; ++Bucket)
+    {
+        Csv += FString::Printf(TEXT(",Under%gMs"), BucketLimits[Bucket]);
+    }
+    Csv += FString::Printf(TEXT(",From%gMs\n"), BucketLimits[NumBuckets - 2]);
+
+    for (const TPair<FIntPoint, FBoardSamples>& Board : Boards)
+    {
+        const FSummary Summary = Summarize(Board.Value);
+        Csv += FString::Printf(TEXT("%d,%d,%lld,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f"), Board.Key.X, Board.Key.Y, (long long)Board.Value.TotalClicks, Summary.Count,
+            Summary.P50, Summary.P95, Summary.P99, Summary.Mean.Apply, Summary.Mean.Publish, Summary.Mean.Paint);
+        for (const int32 Count : Summary.Buckets)
+        {
+            Csv += FString::Printf(TEXT(",%d"), Count);
+        }
+        Csv += TEXT("\n");
+    }
+    return FFileHelper::SaveStringToFile(Csv, *Filename);
+}
+
+static FAutoConsoleCommand LatencyDumpCommand(
+    TEXT("Minesweeper.Latency.Dump"),
+    TEXT("Write the click-to-paint latency histograms of every board size to a CSV file. Usage: Minesweeper.Latency.Dump [Path=Saved/Minesweeper/Latency.csv]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const FString Filename = Args.Num() > 0 ? Args[0] : FPaths::ProjectSavedDir() / TEXT("Minesweeper/Latency.csv");
+        if (FMinesweeperInputLatency::Get().DumpCsv(Filename))
+        {
+            UE_LOG(LogMinesweeperLatency, Log, TEXT("Wrote click-to-paint latency to %s"), *Filename);
+        }
+        else
+        {
+            UE_LOG(LogMinesweeperLatency, Error, TEXT("Could not write %s"), *Filename);
+        }
+    }));
@@ -0,0 +1,55 @@
+// MinesweeperScriptGame.cpp
+#include "MinesweeperScriptGame.h"
+
+static_assert(uint8(EMinesweeperActionType::Reveal) == uint8(FMinesweeperGame::EActionType::Reveal)
+	&& uint8(EMinesweeperActionType::Flag) == uint8(FMinesweeperGame::EActionType::Flag)
+	&& uint8(EMinesweeperActionType::Chord) == uint8(FMinesweeperGame::EActionType::Chord),
+	"Script action types must match the engine's");
+
+void UMinesweeperScriptGame::NewGame(int32 Width, int32 Height, int32 BombCount, int32 Seed)
+{
+    Game.NewGame(Width, Height, BombCount, Seed);
+}
+
+FMinesweeperScriptDelta UMinesweeperScriptGame::ApplyActions(const TArray<FMinesweeperScriptAction>& Actions)
+{
+    TArray<FMinesweeperGame::FAction> GameActions;
+    GameActions.Reserve(Actions.Num());
+    for (const FMinesweeperScriptAction& Action : Actions)
+    {
+        GameActions.Add({ FMinesweeperGame::EActionType(Action.Type), Action.X, Action.Y });
+    }
+
+    FMinesweeperScriptDelta Delta;
+    Delta.NumApplied = Game.ApplyActions(GameActions, &Delta.RevealedTiles, &Delta.FlaggedTiles);
+    Delta.bGameOver = Game.IsGameOver();
+    Delta.bGameWon = Game.IsGameWon();
+    Delta.RemainingMines = Game.GetRemainingMines();
+    return Delta;
+}
+
+TArray<int32> UMinesweeperScriptGame::GetVisibleBoard() const
+{
+    TArray<int32> Board;
+    Board.SetNumUninitialized(Game.GetWidth() * Game.GetHeight());
+
+    for (int32 Y = 0; Y < Game.GetHeight(); ++Y)
+    {
+        for (int32 X = 0; X < Game.GetWidth(); ++X)
+        {
+            const FMinesweeperGame::FTile Tile = Game.GetTile(X, Y);
+            int32& Value = Board[Y * Game.GetWidth() + X];
+
+            if (Tile.State == FMinesweeperGame::ETileState::Hidden)
+            {
+                Value = Tile.bIsFlagged ? FlaggedTile : HiddenTile;
+            }
+            else
+            {
+                Value = Tile.bIsBomb ? MineTile : Tile.AdjacentBombs;
+            }
+        }
+    }
+
+    return Board;
+}
@@ -0,0 +1,384 @@
+// MinesweeperSpectatorServer.cpp
+#include "MinesweeperSpectatorServer.h"
+#include "MinesweeperDelta.h"
+#include "MinesweeperTool.h"
+#include "Common/TcpListener.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperSpectator, Log, All);
+
+// Large enough that the socket takes a typical delta of a 4096x4096 board in one send
+static constexpr int32 SendBufferBytes = 4 * 1024 * 1024;
+
+// How long the sender sleeps while a viewer's socket is full
+static constexpr float BackloggedSleepSeconds = 0.001f;
+
+FMinesweeperSpectatorServer::FMinesweeperSpectatorServer()
+    : bStopping(false)
+    , NumViewers(0)
+    , Port(0)
+    , bSourceChanged(false)
+{
+}
+
+FMinesweeperSpectatorServer::~FMinesweeperSpectatorServer()
+{
+    Stop();
+}
+
+bool FMinesweeperSpectatorServer::Start(uint32 InPort)
+{
+    Stop();
+
+    // Bound here rather than by the listener's thread, so a port in use fails the call
+    FSocket* ListenSocket = FTcpSocketBuilder(TEXT("MinesweeperSpectators"))
+        .AsReusable()
+        .BoundToEndpoint(FIPv4Endpoint(FIPv4Address::InternalLoopback, InPort))
+        .Listening(MaxViewers)
+        .Build();
+    if (ListenSocket == nullptr)
+    {
+        UE_LOG(LogMinesweeperSpectator, Error, TEXT("Could not listen for spectators on 127.0.0.1:%u"), InPort);
+        return false;
+    }
+
+    Port = InPort;
+    bStopping = false;
+    Sender = Async(EAsyncExecution::Thread, [this]() { RunSender(); });
+
+    Listener = MakeUnique<FTcpListener>(*ListenSocket, FTimespan::FromMilliseconds(100));
+    Listener->OnConnectionAccepted().BindRaw(this, &FMinesweeperSpectatorServer::OnConnectionAccepted);
+
+    UE_LOG(LogMinesweeperSpectator, Log, TEXT("Streaming deltas to spectators on 127.0.0.1:%u"), Port);
+    return true;
+}
+
+void FMinesweeperSpectatorServer::Stop()
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+
+    // Stop accepting first, so nothing is handed to the sender after it has gone
+    Listener.Reset();
+    bStopping = true;
+    Sender.Wait();
+
+    FScopeLock ScopeLock(&Lock);
+    for (FSocket* Socket : AcceptedSockets)
+    {
+        CloseSocket(Socket);
+    }
+    AcceptedSockets.Reset();
+    NumViewers = 0;
+
+    UE_LOG(LogMinesweeperSpectator, Log, TEXT("Stopped streaming to spectators on port %u"), Port);
+}
+
+void FMinesweeperSpectatorServer::SetSource(TSharedPtr<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> InSource)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (Source != InSource)
+    {
+        Source = MoveTemp(InSource);
+        bSourceChanged = true;
+    }
+}
+
+bool FMinesweeperSpectatorServer::OnConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (NumViewers + AcceptedSockets.Num() >= MaxViewers)
+    {
+        UE_LOG(LogMinesweeperSpectator, Warning, TEXT("Turned away a spectator from %s; %d are watching"), *Endpoint.ToString(), MaxViewers);
+        return false;
+    }
+
+    int32 ActualSendBufferBytes = 0;
+    Socket->SetNonBlocking(true);
+    Socket->SetNoDelay(true);
+    Socket->SetSendBufferSize(SendBufferBytes, ActualSendBufferBytes);
+    AcceptedSockets.Add(Socket);
+    return true;
+}
+
+void FMinesweeperSpectatorServer::RunSender()
+{
+    TArray<FViewer> Viewers;
+    TMap<const FMinesweeperGame*, TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe>> Encoded;
+
+    while (!bStopping)
+    {
+        TSharedPtr<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> CurrentSource;
+        {
+            FScopeLock ScopeLock(&Lock);
+            for (FSocket* Socket : AcceptedSockets)
+            {
+                Viewers.AddDefaulted_GetRef().Socket = Socket;
+            }
+            AcceptedSockets.Reset();
+
+            // A new game starts every viewer over from a keyframe
+            if (bSourceChanged)
+            {
+                for (FViewer& Viewer : Viewers)
+                {
+                    Viewer.State.Reset();
+                }
+                bSourceChanged = false;
+            }
+            CurrentSource = Source;
+        }
+
+        const TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> Latest = CurrentSource.IsValid() ? CurrentSource->GetLatest() : nullptr;
+
+        // A viewer is only given a new message once it has taken the last one, and that message
+        // covers every state it missed in the meantime. Viewers at the same state share it.
+        Encoded.Reset();
+        bool bBacklogged = false;
+        for (int32 Index = Viewers.Num() - 1; Index >= 0; --Index)
+        {
+            FViewer& Viewer = Viewers[Index];
+            if (!Viewer.Message.IsValid() && Latest.IsValid() && Viewer.State != Latest)
+            {
+                TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe>& Message = Encoded.FindOrAdd(Viewer.State.Get());
+                if (!Message.IsValid())
+                {
+                    const TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Bytes = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+                    FMinesweeperDelta::Encode(Viewer.State.Get(), *Latest, *Bytes);
+                    Message = Bytes;
+                }
+
+                Viewer.Message = Message;
+                Viewer.MessageOffset = 0;
+                Viewer.State = Latest;
+            }
+
+            if (!SendPending(Viewer))
+            {
+                CloseSocket(Viewer.Socket);
+                Viewers.RemoveAtSwap(Index);
+                continue;
+            }
+            bBacklogged |= Viewer.Message.IsValid();
+        }
+        NumViewers = Viewers.Num();
+
+        FPlatformProcess::Sleep(bBacklogged ? BackloggedSleepSeconds : PollSeconds);
+    }
+
+    for (FViewer& Viewer : Viewers)
+    {
+        CloseSocket(Viewer.Socket);
+    }
+}
+
+bool FMinesweeperSpectatorServer::SendPending(FViewer& Viewer)
+{
+    if (!Viewer.Message.IsValid())
+    {
+        return Viewer.Socket->GetConnectionState() == SCS_Connected;
+    }
+
+    const TArray<uint8>& Bytes = *Viewer.Message;
+    int32 BytesSent = 0;
+    if (!Viewer.Socket->Send(Bytes.GetData() + Viewer.MessageOffset, Bytes.Num() - Viewer.MessageOffset, BytesSent))
+    {
+        // A full socket is backpressure from a slow viewer, not an error
+        const ESocketErrors Error = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+        return Error == SE_EWOULDBLOCK || Error == SE_NO_ERROR;
+    }
+
+    Viewer.MessageOffset += BytesSent;
+    if (Viewer.MessageOffset == Bytes.Num())
+    {
+        Viewer.Message.Reset();
+        Viewer.MessageOffset = 0;
+    }
+    return true;
+}
+
+void FMinesweeperSpectatorServer::CloseSocket(FSocket* Socket)
+{
+    Socket->Close();
+    ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+}
+
+// A viewer in another thread that mirrors the board from a spectator stream, as an external tool would
+class FMinesweeperSpectatorBenchmarkViewer
+{
+public:
+    TArray<uint8> TileCodes;
+    std::atomic<uint64> Version;
+    std::atomic<bool> bDone;
+    int64 Bytes;
+    int32 Messages;
+    int32 Failures;
+    double ApplySeconds;
+
+    FMinesweeperSpectatorBenchmarkViewer()
+        : Version(0)
+        , bDone(false)
+        , Bytes(0)
+        , Messages(0)
+        , Failures(0)
+        , ApplySeconds(0.0)
+    {
+    }
+
+    // Read until bDone is set and the viewer has reached StopVersion
+    void Run(uint32 Port, const std::atomic<uint64>& StopVersion)
+    {
+        ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+        FSocket* Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("MinesweeperSpectator"), false);
+        if (Socket == nullptr || !Socket->Connect(*FIPv4Endpoint(FIPv4Address::InternalLoopback, Port).ToInternetAddr()))
+        {
+            Failures++;
+            if (Socket != nullptr)
+            {
+                SocketSubsystem->DestroySocket(Socket);
+            }
+            return;
+        }
+
+        constexpr int32 ReadBytes = 1024 * 1024;
+        TArray<uint8> Received;
+        while (!(bDone && Version >= StopVersion))
+        {
+            if (!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(50)))
+            {
+                continue;
+            }
+
+            const int32 Start = Received.Num();
+            int32 BytesRead = 0;
+            Received.AddUninitialized(ReadBytes);
+            const bool bRead = Socket->Recv(Received.GetData() + Start, ReadBytes, BytesRead);
+            Received.SetNum(Start + BytesRead, false);
+            if (!bRead || BytesRead == 0)
+            {
+                Failures++;
+                break;
+            }
+            Bytes += BytesRead;
+
+            // Messages are framed by the size in their header
+            int32 Offset = 0;
+            FMinesweeperDelta::FHeader Header;
+            while (FMinesweeperDelta::ReadHeader(TArrayView<const uint8>(Received.GetData() + Offset, Received.Num() - Offset), Header)
+                && int64(Header.Size) <= Received.Num() - Offset)
+            {
+                const double ApplyStart = FPlatformTime::Seconds();
+                Failures += !FMinesweeperDelta::Apply(TArrayView<const uint8>(Received.GetData() + Offset, Header.Size), TileCodes, Header);
+                ApplySeconds += FPlatformTime::Seconds() - ApplyStart;
+                Messages++;
+                Offset += Header.Size;
+                Version = Header.ToVersion;
+            }
+            Received.RemoveAt(0, Offset, false);
+        }
+
+        Socket->Close();
+        SocketSubsystem->DestroySocket(Socket);
+    }
+};
+
+static FAutoConsoleCommand SpectateStartCommand(
+    TEXT("Minesweeper.Spectate.Start"),
+    TEXT("Stream the Minesweeper window's game as binary deltas over TCP on 127.0.0.1. Usage: Minesweeper.Spectate.Start [Port=8791]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const uint32 Port = Args.Num() > 0 ? uint32(FMath::Clamp(FCString::Atoi(*Args[0]), 1, 65535)) : FMinesweeperSpectatorServer::DefaultPort;
+        FMinesweeperToolModule::Get().StartSpectatorServer(Port);
+    }));
+
+static FAutoConsoleCommand SpectateStopCommand(
+    TEXT("Minesweeper.Spectate.Stop"),
+    TEXT("Stop streaming to spectators. Usage: Minesweeper.Spectate.Stop"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        FMinesweeperToolModule::Get().StopSpectatorServer();
+    }));
+
+static FAutoConsoleCommand SpectateBenchmarkCommand(
+    TEXT("Minesweeper.Spectate.Bench"),
+    TEXT("Play random moves on a large board as fast as possible while a viewer thread mirrors it over a local spectator socket, then check the mirror and report how far the viewer fell behind. Usage: Minesweeper.Spectate.Bench [Side=4096] [Seconds=5] [Port=8792]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 Side = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 16, 8192) : 4096;
+        const double Seconds = Args.Num() > 1 ? FMath::Max(0.1, FCString::Atod(*Args[1])) : 5.0;
+        const uint32 Port = Args.Num() > 2 ? uint32(FMath::Clamp(FCString::Atoi(*Args[2]), 1, 65535)) : FMinesweeperSpectatorServer::DefaultPort + 1;
+
+        FMinesweeperGame Game;
+        FMinesweeperSpectatorServer Server;
+        Server.SetSource(Game.GetReadSnapshotSource());
+        if (!Server.Start(Port))
+        {
+            return;
+        }
+
+        FMinesweeperSpectatorBenchmarkViewer Viewer;
+        std::atomic<uint64> StopVersion(0);
+        TFuture<void> ViewerThread = Async(EAsyncExecution::Thread, [&Viewer, &StopVersion, Port]() { Viewer.Run(Port, StopVersion); });
+
+        FRandomStream Random(Side);
+        Game.NewGame(Side, Side, Side * Side / 10, Side);
+        int32 Moves = 0;
+        int64 StatesBehind = 0;
+        uint64 MaxStatesBehind = 0;
+        const double StartTime = FPlatformTime::Seconds();
+        while (FPlatformTime::Seconds() - StartTime < Seconds)
+        {
+            if (Game.IsGameOver() || Game.IsGameWon())
+            {
+                Game.NewGame(Side, Side, Side * Side / 10, Random.GetUnsignedInt());
+            }
+            else if (Random.FRand() < 0.2f)
+            {
+                Game.ToggleFlag(Random.RandHelper(Side), Random.RandHelper(Side));
+            }
+            else
+            {
+                Game.RevealTile(Random.RandHelper(Side), Random.RandHelper(Side));
+            }
+
+            const uint64 Behind = Game.GetStateVersion() - FMath::Min<uint64>(Viewer.Version, Game.GetStateVersion());
+            StatesBehind += Behind;
+            MaxStatesBehind = FMath::Max(MaxStatesBehind, Behind);
+            Moves++;
+        }
+        const double PlaySeconds = FPlatformTime::Seconds() - StartTime;
+
+        // Give the viewer up to ten seconds to catch up with the final state
+        StopVersion = Game.GetStateVersion();
+        Viewer.bDone = true;
+        const double CatchUpStart = FPlatformTime::Seconds();
+        const bool bCaughtUp = ViewerThread.WaitFor(FTimespan::FromSeconds(10.0));
+        const double CatchUpSeconds = FPlatformTime::Seconds() - CatchUpStart;
+        Server.Stop();
+        ViewerThread.Wait();
+
+        int32 Mismatches = Viewer.TileCodes.Num() == Side * Side ? 0 : Side * Side;
+        for (int32 Y = 0; Y < Side && Mismatches == 0; ++Y)
+        {
+            for (int32 X = 0; X < Side; ++X)
+            {
+                Mismatches += Viewer.TileCodes[Y * Side + X] != uint8(FMinesweeperDelta::GetTileCode(Game.GetTile(X, Y)));
+            }
+        }
+
+        UE_LOG(LogMinesweeperSpectator, Log, TEXT("%dx%d board, %d moves in %.2f s (%.0f/s): the viewer took %d messages (%.1f states each), %.2f MB, applying each in %.2f ms"),
+            Side, Side, Moves, PlaySeconds, Moves / PlaySeconds, Viewer.Messages, Viewer.Messages > 0 ? double(Game.GetStateVersion()) / Viewer.Messages : 0.0,
+            Viewer.Bytes / (1024.0 * 1024.0), Viewer.Messages > 0 ? Viewer.ApplySeconds * 1000.0 / Viewer.Messages : 0.0);
+        UE_LOG(LogMinesweeperSpectator, Log, TEXT("  %.1f states behind on average, %llu at most; %s the final state %.1f ms after the last move; %d errors, %d tiles differ"),
+            Moves > 0 ? double(StatesBehind) / Moves : 0.0, (unsigned long long)MaxStatesBehind, bCaughtUp ? TEXT("reached") : TEXT("did not reach"), CatchUpSeconds * 1000.0, Viewer.Failures, Mismatches);
+    }));
@@ -0,0 +1,79 @@
+// MinesweeperStartupBench.cpp
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperStartup, Log, All);
+
+struct FStartupRun
+{
+    // Launch to exit of the child editor, and the engine's own initialization time from its log
+    double WallSeconds = 0.0;
+    double InitSeconds = 0.0;
+};
+
+// Start an editor on this project that quits on its first frame, and time it
+static bool RunEditorForStartup(bool bWithPlugin, FStartupRun& OutRun)
+{
+    FString Params = FString::Printf(TEXT("\"%s\" -unattended -nosplash -nosound -nop4 -stdout -FullStdOutLogOutput -ExecCmds=\"Quit\""),
+        *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+    if (!bWithPlugin)
+    {
+        Params += TEXT(" -DisablePlugins=MinesweeperTool");
+    }
+
+    int32 ReturnCode = 0;
+    FString StdOut;
+    FString StdErr;
+    const double Start = FPlatformTime::Seconds();
+    if (!FPlatformProcess::ExecProcess(FPlatformProcess::ExecutablePath(), *Params, &ReturnCode, &StdOut, &StdErr))
+    {
+        return false;
+    }
+    OutRun.WallSeconds = FPlatformTime::Seconds() - Start;
+
+    static const TCHAR* InitMarker = TEXT("(Engine Initialization) Total time: ");
+    const int32 Marker = StdOut.Find(InitMarker);
+    OutRun.InitSeconds = Marker != INDEX_NONE ? FCString::Atod(*StdOut + Marker + FCString::Strlen(InitMarker)) : 0.0;
+    return true;
+}
+
+static double MedianSeconds(TArray<double> Values)
+{
+    Values.Sort();
+    return Values.Num() > 0 ? Values[Values.Num() / 2] : 0.0;
+}
+
+static FAutoConsoleCommand StartupBenchmarkCommand(
+    TEXT("Minesweeper.Bench.Startup"),
+    TEXT("Launch this project's editor several times with and without the Minesweeper plugin, each run quitting on its first frame, and report the median engine initialization and launch-to-exit times. The editor waits until every run is done. Usage: Minesweeper.Bench.Startup [Runs=3]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+    {
+        const int32 NumRuns = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 20) : 3;
+
+        // Alternate the two so disk caches warm up for both alike
+        TArray<double> InitSeconds[2];
+        TArray<double> WallSeconds[2];
+        for (int32 Run = 0; Run < NumRuns; ++Run)
+        {
+            for (int32 WithPlugin = 0; WithPlugin < 2; ++WithPlugin)
+            {
+                FStartupRun Result;
+                if (!RunEditorForStartup(WithPlugin != 0, Result))
+                {
+                    UE_LOG(LogMinesweeperStartup, Error, TEXT("Could not launch %s"), FPlatformProcess::ExecutablePath());
+                    return;
+                }
+                InitSeconds[WithPlugin].Add(Result.InitSeconds);
+                WallSeconds[WithPlugin].Add(Result.WallSeconds);
+                UE_LOG(LogMinesweeperStartup, Log, TEXT("Run %d %s the plugin: initialization %.2f s, launch to exit %.2f s"),
+                    Run + 1, WithPlugin ? TEXT("with") : TEXT("without"), Result.InitSeconds, Result.WallSeconds);
+            }
+        }
+
+        UE_LOG(LogMinesweeperStartup, Log, TEXT("Editor startup over %d runs, median: initialization %.2f s with the plugin, %.2f s without (%+.0f ms); launch to exit %.2f s with, %.2f s without (%+.0f ms)"),
+            NumRuns, MedianSeconds(InitSeconds[1]), MedianSeconds(InitSeconds[0]), (MedianSeconds(InitSeconds[1]) - MedianSeconds(InitSeconds[0])) * 1000.0,
+            MedianSeconds(WallSeconds[1]), MedianSeconds(WallSeconds[0]), (MedianSeconds(WallSeconds[1]) - MedianSeconds(WallSeconds[0])) * 1000.0);
+    }));
@@ -5,6 +5,8 @@
 #include "MinesweeperToolCommands.h"
 #include "LevelEditor.h"
 #include "SMinesweeperWindow.h"
+#include "MinesweeperGameServer.h"
+#include "MinesweeperSpectatorServer.h"
 #include "Widgets/Docking/SDockTab.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Text/STextBlock.h"
@@ -16,39 +18,54 @@ static const FName MinesweeperTabName("MinesweeperTool");
 
 void FMinesweeperToolModule::StartupModule()
 {
-    // Register the styles and commands for our plugin
+    // Only what the toolbar and menu entries need is set up during editor boot: the style set
+    // holding their icon and the tab spawner they open. The commands wait for the first time the
+    // tab is spawned; see InitializeOnFirstOpen. MinesweeperCore is a link dependency and loads
+    // with the plugin, so its console commands work in commandlets and servers too.
     FMinesweeperToolStyle::Initialize();
-    FMinesweeperToolStyle::ReloadTextures();
+    
+    // Register menus once the tool menus are ready
+    UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FMinesweeperToolModule::RegisterMenus));
+    
+    // Register a nomad tab spawner for our plugin window
+    FGlobalTabmanager::Get()->RegisterNomadTabSpawner(MinesweeperTabName, 
+        FOnSpawnTab::CreateRaw(this, &FMinesweeperToolModule::OnSpawnPluginTab))
+        .SetDisplayName(LOCTEXT("MinesweeperTabTitle", "Minesweeper"))
+        .SetMenuType(ETabSpawnerMenuType::Hidden);
+}
 
+void FMinesweeperToolModule::InitializeOnFirstOpen()
+{
+    if (bInitialized)
+    {
+        return;
+    }
+    bInitialized = true;
+    
+    // Register the commands for our plugin, so the window can be bound to a shortcut
     FMinesweeperToolCommands::Register();
     
-    // Register plugin callbacks
     PluginCommands = MakeShareable(new FUICommandList);
-    
-    // Map the plugin button to our callback
     PluginCommands->MapAction(
         FMinesweeperToolCommands::Get().OpenPluginWindow,
         FExecuteAction::CreateRaw(this, &FMinesweeperToolModule::PluginButtonClicked),
         FCanExecuteAction());
-    
-    // Register menus
-    RegisterMenus();
-    
-    // Register a nomad tab spawner for our plugin window
-    FGlobalTabmanager::Get()->RegisterNomadTabSpawner(MinesweeperTabName, 
-        FOnSpawnTab::CreateRaw(this, &FMinesweeperToolModule::OnSpawnPluginTab))
-        .SetDisplayName(LOCTEXT("MinesweeperTabTitle", "Minesweeper"))
-        .SetMenuType(ETabSpawnerMenuType::Hidden);
 }
 
 void FMinesweeperToolModule::ShutdownModule()
 {
+    StopGameServer();
+    StopSpectatorServer();
+    
     // Unregister all the resources we've registered
     UToolMenus::UnRegisterStartupCallback(this);
     UToolMenus::UnregisterOwner(this);
     
     FMinesweeperToolStyle::Shutdown();
-    FMinesweeperToolCommands::Unregister();
+    if (bInitialized)
+    {
+        FMinesweeperToolCommands::Unregister();
+    }
     
     // Unregister tab spawner
     FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(MinesweeperTabName);
@@ -59,44 +76,99 @@ void FMinesweeperToolModule::PluginButtonClicked()
     FGlobalTabmanager::Get()->TryInvokeTab(MinesweeperTabName);
 }
 
+bool FMinesweeperToolModule::StartGameServer(uint32 Port, int32 NumShards)
+{
+    StopGameServer();
+    
+    GameServer = MakeShared<FMinesweeperGameServer, ESPMode::ThreadSafe>(NumShards);
+    if (!GameServer->Start(Port))
+    {
+        GameServer.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FMinesweeperToolModule::StopGameServer()
+{
+    if (GameServer.IsValid())
+    {
+        GameServer->Stop();
+        GameServer.Reset();
+    }
+}
+
+bool FMinesweeperToolModule::StartSpectatorServer(uint32 Port)
+{
+    StopSpectatorServer();
+    
+    SpectatorServer = MakeUnique<FMinesweeperSpectatorServer>();
+    SpectatorServer->SetSource(SpectatedGame);
+    if (!SpectatorServer->Start(Port))
+    {
+        SpectatorServer.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FMinesweeperToolModule::StopSpectatorServer()
+{
+    SpectatorServer.Reset();
+}
+
+void FMinesweeperToolModule::SetSpectatedGame(TSharedPtr<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> Source)
+{
+    SpectatedGame = Source;
+    if (SpectatorServer.IsValid())
+    {
+        SpectatorServer->SetSource(MoveTemp(Source));
+    }
+}
+
 void FMinesweeperToolModule::RegisterMenus()
 {
     // Owner will be used for cleanup in call to UToolMenus::UnregisterOwner
     FToolMenuOwnerScoped OwnerScoped(this);
     
+    // The entries call straight into the module, since the commands are not registered until
+    // the window is first opened
+    const FUIAction OpenAction(FExecuteAction::CreateRaw(this, &FMinesweeperToolModule::PluginButtonClicked));
+    const FSlateIcon Icon(FMinesweeperToolStyle::GetStyleSetName(), "MinesweeperTool.OpenPluginWindow");
+    
     // Register the "Minesweeper" button in the toolbar
     {
         UToolMenu* ToolbarMenu = UToolMenus::Get()->ExtendMenu("LevelEditor.LevelEditorToolBar.PlayToolBar");
         FToolMenuSection& Section = ToolbarMenu->FindOrAddSection("Minesweeper");
-        {
-            FToolMenuEntry& Entry = Section.AddEntry(
-                FToolMenuEntry::InitToolBarButton(
-                    FMinesweeperToolCommands::Get().OpenPluginWindow,
-                    FText::GetEmpty(),
-                    LOCTEXT("MinesweeperToolbarTooltip", "Open the Minesweeper game"),
-                    FSlateIcon(FMinesweeperToolStyle::GetStyleSetName(), "MinesweeperTool.PluginAction")
-                )
-            );
-            Entry.SetCommandList(PluginCommands);
-        }
+        Section.AddEntry(
+            FToolMenuEntry::InitToolBarButton(
+                "OpenMinesweeper",
+                OpenAction,
+                FText::GetEmpty(),
+                LOCTEXT("MinesweeperToolbarTooltip", "Open the Minesweeper game"),
+                Icon
+            )
+        );
     }
     
     // Register the "Minesweeper" menu entry
     {
         UToolMenu* Menu = UToolMenus::Get()->ExtendMenu("LevelEditor.MainMenu.Tools");
         FToolMenuSection& Section = Menu->FindOrAddSection("MinesweeperTools");
-        Section.AddMenuEntryWithCommandList(
-            FMinesweeperToolCommands::Get().OpenPluginWindow,
-            PluginCommands,
+        Section.AddMenuEntry(
+            "OpenMinesweeper",
             LOCTEXT("MinesweeperMenuLabel", "Minesweeper"),
             LOCTEXT("MinesweeperMenuTooltip", "Open Minesweeper game"),
-            FSlateIcon(FMinesweeperToolStyle::GetStyleSetName(), "MinesweeperTool.PluginAction")
+            Icon,
+            OpenAction
         );
     }
 }
 
 TSharedRef<SDockTab> FMinesweeperToolModule::OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs)
 {
+    InitializeOnFirstOpen();
+    
     // Create the Minesweeper window
     TSharedRef<SDockTab> DockTab = SNew(SDockTab)
         .TabRole(ETabRole::NomadTab)
@@ -5,6 +5,7 @@
 #include "Styling/SlateTypes.h"
 #include "Styling/CoreStyle.h"
 #include "Brushes/SlateRoundedBoxBrush.h"
+#include "MinesweeperInputLatency.h"
 
 #define LOCTEXT_NAMESPACE "MinesweeperTool"
 
@@ -16,6 +17,9 @@ void SMinesweeperTile::Construct(const FArguments& InArgs)
     Y = InArgs._Y;
     Game = InArgs._Game;
     OnTileClicked = InArgs._OnTileClicked;
+    OnTileRightClicked = InArgs._OnTileRightClicked;
+    OnTileChorded = InArgs._OnTileChorded;
+    HintColor = InArgs._HintColor;
     
     ChildSlot
     [
@@ -37,9 +41,37 @@ void SMinesweeperTile::Construct(const FArguments& InArgs)
     ];
 }
 
+void SMinesweeperTile::Rebind(int32 InX, int32 InY, const FOnClicked& InOnTileClicked, const FOnClicked& InOnTileRightClicked,
+    const FOnClicked& InOnTileChorded, const TAttribute<FLinearColor>& InHintColor)
+{
+    X = InX;
+    Y = InY;
+    OnTileClicked = InOnTileClicked;
+    OnTileRightClicked = InOnTileRightClicked;
+    OnTileChorded = InOnTileChorded;
+    HintColor = InHintColor;
+    
+    // Everything shown is read from the game, so a repaint is all the reset a tile needs
+    Invalidate(EInvalidateWidgetReason::Paint);
+}
+
 FReply SMinesweeperTile::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
 {
-    if (MouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
+    if (Game.IsValid())
+    {
+        FMinesweeperInputLatency::Get().OnInput(*Game);
+    }
+    
+    // Middle-click, or pressing left and right together, chords
+    const bool bBothButtons = MouseEvent.IsMouseButtonDown(EKeys::LeftMouseButton) && MouseEvent.IsMouseButtonDown(EKeys::RightMouseButton);
+    if (MouseEvent.GetEffectingButton() == EKeys::MiddleMouseButton || bBothButtons)
+    {
+        if (OnTileChorded.IsBound())
+        {
+            return OnTileChorded.Execute();
+        }
+    }
+    else if (MouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
     {
         if (OnTileClicked.IsBound())
         {
@@ -47,6 +79,13 @@ FReply SMinesweeperTile::OnMouseButtonDown(const FGeometry& MyGeometry, const FP
             return OnTileClicked.Execute();
         }
     }
+    else if (MouseEvent.GetEffectingButton() == EKeys::RightMouseButton)
+    {
+        if (OnTileRightClicked.IsBound())
+        {
+            return OnTileRightClicked.Execute();
+        }
+    }
     
     return FReply::Handled();  // Changed from Unhandled to ensure we capture all clicks
 }
@@ -73,7 +112,24 @@ int32 SMinesweeperTile::OnPaint(const FPaintArgs& Args, const FGeometry& Allotte
     );
     
     // Call the parent OnPaint to draw child widgets
-    return SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId + 1, InWidgetStyle, bIsEnabled);
+    const int32 MaxLayerId = SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId + 1, InWidgetStyle, bIsEnabled);
+    
+    // Hint overlay, translucent on top of the tile
+    const FLinearColor Hint = HintColor.Get();
+    if (Hint.A > 0.0f && !bIsRevealed)
+    {
+        FSlateDrawElement::MakeBox(
+            OutDrawElements,
+            MaxLayerId + 1,
+            AllottedGeometry.ToPaintGeometry(),
+            FCoreStyle::Get().GetBrush("GenericWhiteBox"),
+            DrawEffects,
+            Hint
+        );
+        return MaxLayerId + 1;
+    }
+    
+    return MaxLayerId;
 }
 
 FSlateColor SMinesweeperTile::GetTileColor() const
@@ -87,7 +143,7 @@ FSlateColor SMinesweeperTile::GetTileColor() const
     
     if (Tile.State == FMinesweeperGame::ETileState::Hidden)
     {
-        return FLinearColor::White;
+        return Tile.bIsFlagged ? FLinearColor::Red : FLinearColor::White;
     }
     else if (Tile.State == FMinesweeperGame::ETileState::Exploded)
     {
@@ -125,7 +181,7 @@ FText SMinesweeperTile::GetTileText() const
     
     if (Tile.State == FMinesweeperGame::ETileState::Hidden)
     {
-        return FText::GetEmpty();
+        return Tile.bIsFlagged ? LOCTEXT("FlagText", "🚩") : FText::GetEmpty();
     }
     else if (Tile.bIsBomb)
     {
@@ -5,10 +5,20 @@
 #include "Widgets/Layout/SGridPanel.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Layout/SBorder.h"
+#include "Widgets/SOverlay.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SSpinBox.h"
+#include "Widgets/Input/SSlider.h"
+#include "Widgets/Input/SCheckBox.h"
 #include "SMinesweeperTile.h"
+#include "MinesweeperTool.h"
+#include "MinesweeperInputLatency.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMinesweeperWindow, Log, All);
 
 #define LOCTEXT_NAMESPACE "MinesweeperTool"
 
@@ -18,6 +28,8 @@ void SMinesweeperWindow::Construct(const FArguments& InArgs)
 {
     // Initialize the game
     Game = MakeShared<FMinesweeperGame>();
+    ReadSnapshots = Game->GetReadSnapshotSource();
+    FMinesweeperToolModule::Get().SetSpectatedGame(ReadSnapshots);
     
     // Create the window content
     ChildSlot
@@ -52,12 +64,60 @@ void SMinesweeperWindow::Construct(const FArguments& InArgs)
             .Font(FCoreStyle::GetDefaultFontStyle("Regular", 16))
         ]
         
+        // Stress report, shown once a stress run ends
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(10, 0, 10, 10)
+        [
+            SNew(SBorder)
+            .BorderImage(FCoreStyle::Get().GetBrush("ToolPanel.GroupBorder"))
+            .Padding(4.0f)
+            .Visibility(this, &SMinesweeperWindow::GetStressReportVisibility)
+            [
+                SAssignNew(StressReportText, STextBlock)
+                .Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+            ]
+        ]
+        
+        // Replay timeline
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(10, 0)
+        [
+            SAssignNew(ReplayTimeline, SSlider)
+            .Value(this, &SMinesweeperWindow::GetReplayTimelineValue)
+            .OnValueChanged(this, &SMinesweeperWindow::OnReplayTimelineScrubbed)
+            .IsEnabled(this, &SMinesweeperWindow::IsReplayPlaying)
+            .ToolTipText(LOCTEXT("ReplayTimelineTooltip", "Drag to scrub through the replay"))
+        ]
+        
         // Game grid
         + SVerticalBox::Slot()
         .FillHeight(1.0f)
         .Padding(10)
         [
-            BuildGameGrid()
+            SNew(SOverlay)
+            
+            + SOverlay::Slot()
+            [
+                BuildGameGrid()
+            ]
+            
+            // Click-to-paint latency, over the top right of the board
+            + SOverlay::Slot()
+            .HAlign(HAlign_Right)
+            .VAlign(VAlign_Top)
+            [
+                SNew(SBorder)
+                .BorderImage(FCoreStyle::Get().GetBrush("ToolPanel.GroupBorder"))
+                .Padding(4.0f)
+                .Visibility(this, &SMinesweeperWindow::GetLatencyVisibility)
+                [
+                    SNew(STextBlock)
+                    .Text(this, &SMinesweeperWindow::GetLatencyText)
+                    .Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+                ]
+            ]
         ]
     ];
     
@@ -75,33 +135,376 @@ FReply SMinesweeperWindow::OnNewGameClicked()
     int32 Height = HeightSpinBox->GetValue();
     int32 BombCount = BombCountSpinBox->GetValue();
     
+    // Leave any replay or stress run that is playing
+    if (IsStressRunning())
+    {
+        StopStress();
+    }
+    ReplayPlayer.Reset();
+    PlaybackKeyframes = FMinesweeperReplayKeyframes();
+    
     // Initialize new game
     Game->NewGame(Width, Height, BombCount);
+    Recorder.Begin(*Game, GetLastGameReplayPath());
     
     // Update UI
     UpdateGameGrid();
     UpdateGameStatus();
+    RefreshHint();
     
     return FReply::Handled();
 }
 
 FReply SMinesweeperWindow::OnTileClicked(int32 X, int32 Y)
 {
-    // Ignore clicks if game is over
-    if (Game->IsGameOver() || Game->IsGameWon())
+    // Ignore clicks if game is over or a replay or stress run is playing
+    if (Game->IsGameOver() || Game->IsGameWon() || IsReplayPlaying() || IsStressRunning())
+    {
+        return FReply::Handled();
+    }
+    
+    // Process the click; clicks on open or flagged tiles change nothing and are not recorded
+    if (Game->RevealTile(X, Y))
+    {
+        FMinesweeperInputLatency::Get().OnApplied(*Game);
+        Recorder.RecordAction(FMinesweeperReplay::EAction::Reveal, Y * Game->GetWidth() + X);
+        
+        if (Game->IsGameOver() || Game->IsGameWon())
+        {
+            Recorder.End();
+        }
+        
+        // Update status
+        UpdateGameStatus();
+        RefreshHint();
+        FMinesweeperInputLatency::Get().OnPublished();
+    }
+    
+    return FReply::Handled();
+}
+
+FReply SMinesweeperWindow::OnTileRightClicked(int32 X, int32 Y)
+{
+    if (IsReplayPlaying() || IsStressRunning())
+    {
+        return FReply::Handled();
+    }
+    
+    // Flag or unflag the tile
+    if (Game->ToggleFlag(X, Y))
+    {
+        FMinesweeperInputLatency::Get().OnApplied(*Game);
+        Recorder.RecordAction(FMinesweeperReplay::EAction::Flag, Y * Game->GetWidth() + X);
+        UpdateGameStatus();
+        RefreshHint();
+        FMinesweeperInputLatency::Get().OnPublished();
+    }
+    
+    return FReply::Handled();
+}
+
+FReply SMinesweeperWindow::OnTileChorded(int32 X, int32 Y)
+{
+    if (IsReplayPlaying() || IsStressRunning())
+    {
+        return FReply::Handled();
+    }
+    
+    // Reveal the neighbors of a satisfied number
+    if (Game->ChordTile(X, Y))
+    {
+        FMinesweeperInputLatency::Get().OnApplied(*Game);
+        Recorder.RecordAction(FMinesweeperReplay::EAction::Chord, Y * Game->GetWidth() + X);
+        
+        if (Game->IsGameOver() || Game->IsGameWon())
+        {
+            Recorder.End();
+        }
+        
+        UpdateGameStatus();
+        RefreshHint();
+        FMinesweeperInputLatency::Get().OnPublished();
+    }
+    
+    return FReply::Handled();
+}
+
+FReply SMinesweeperWindow::OnReplayClicked()
+{
+    if (IsStressRunning())
     {
         return FReply::Handled();
     }
     
-    // Process the click
-    Game->RevealTile(X, Y);
+    if (!ReplayPlayer.IsValid())
+    {
+        if (Recorder.GetReplay().GetActionBytes().Num() == 0)
+        {
+            return FReply::Handled();
+        }
+        
+        // Play back a copy so the recorder can start on the next game
+        Recorder.End();
+        PlaybackReplay = Recorder.GetReplay();
+        PlaybackKeyframes.Build(PlaybackReplay);
+        ReplayPlayer = MakeUnique<FMinesweeperReplayPlayer>(PlaybackReplay);
+        ReplayPlayer->Start(*Game);
+        PlaybackPositionSeconds = 0.0;
+        
+        UpdateGameGrid();
+        RefreshHint();
+    }
+    else if (ReplayPlayer->IsFinished())
+    {
+        // Watch again from the start
+        PlaybackPositionSeconds = 0.0;
+        ReplayPlayer->SeekToTime(*Game, PlaybackPositionSeconds, &PlaybackKeyframes);
+    }
+    
+    // Play on from the current timeline position
+    PlaybackStartTime = FSlateApplication::Get().GetCurrentTime() - PlaybackPositionSeconds;
+    UpdateGameStatus();
+    
+    if (!bReplayTimerActive)
+    {
+        bReplayTimerActive = true;
+        RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SMinesweeperWindow::TickReplay));
+    }
+    
+    return FReply::Handled();
+}
+
+EActiveTimerReturnType SMinesweeperWindow::TickReplay(double InCurrentTime, float InDeltaTime)
+{
+    if (!ReplayPlayer.IsValid() || ReplayPlayer->IsFinished())
+    {
+        bReplayTimerActive = false;
+        return EActiveTimerReturnType::Stop;
+    }
+    
+    // Apply every action that was made by this point in the original game
+    PlaybackPositionSeconds = FMath::Min(InCurrentTime - PlaybackStartTime, PlaybackKeyframes.GetDurationSeconds());
+    ReplayPlayer->AdvanceTo(*Game, PlaybackPositionSeconds);
+    UpdateGameStatus();
+    
+    return EActiveTimerReturnType::Continue;
+}
+
+float SMinesweeperWindow::GetReplayTimelineValue() const
+{
+    const double Duration = PlaybackKeyframes.GetDurationSeconds();
+    return ReplayPlayer.IsValid() && Duration > 0.0 ? float(PlaybackPositionSeconds / Duration) : 0.0f;
+}
+
+void SMinesweeperWindow::OnReplayTimelineScrubbed(float NewValue)
+{
+    if (!ReplayPlayer.IsValid())
+    {
+        return;
+    }
     
-    // Update status
+    // Keyframes keep this to one restore plus a short run of actions, so it can follow the drag
+    PlaybackPositionSeconds = NewValue * PlaybackKeyframes.GetDurationSeconds();
+    ReplayPlayer->SeekToTime(*Game, PlaybackPositionSeconds, &PlaybackKeyframes);
+    PlaybackStartTime = FSlateApplication::Get().GetCurrentTime() - PlaybackPositionSeconds;
     UpdateGameStatus();
+}
+
+FReply SMinesweeperWindow::OnHintClicked()
+{
+    if (!IsReplayPlaying() && !IsStressRunning())
+    {
+        RequestHint();
+    }
     
     return FReply::Handled();
 }
 
+void SMinesweeperWindow::OnAutoHintChanged(ECheckBoxState NewState)
+{
+    bAutoHint = NewState == ECheckBoxState::Checked;
+    RefreshHint();
+}
+
+void SMinesweeperWindow::OnShowLatencyChanged(ECheckBoxState NewState)
+{
+    bShowLatency = NewState == ECheckBoxState::Checked;
+}
+
+FText SMinesweeperWindow::GetLatencyText() const
+{
+    // Only rebuild the text when a click has been recorded or the board size changed
+    const FMinesweeperInputLatency& Latency = FMinesweeperInputLatency::Get();
+    const FIntPoint BoardSize(Game->GetWidth(), Game->GetHeight());
+    if (Latency.GetRevision() != LatencyTextRevision || BoardSize != LatencyTextBoardSize || LatencyText.IsEmpty())
+    {
+        LatencyText = FText::FromString(Latency.Describe(BoardSize.X, BoardSize.Y));
+        LatencyTextRevision = Latency.GetRevision();
+        LatencyTextBoardSize = BoardSize;
+    }
+    return LatencyText;
+}
+
+void SMinesweeperWindow::RequestHint()
+{
+    HintService.RequestHint(ReadSnapshots->GetLatest(), FOnMinesweeperHintReady::CreateSP(this, &SMinesweeperWindow::OnHintReady));
+}
+
+void SMinesweeperWindow::RefreshHint()
+{
+    CurrentHint = FMinesweeperHint();
+    
+    // Stress games are not hinted, like replays
+    if (bAutoHint && !IsReplayPlaying() && !IsStressRunning())
+    {
+        RequestHint();
+    }
+    else
+    {
+        HintService.Cancel();
+    }
+}
+
+void SMinesweeperWindow::OnHintReady(const FMinesweeperHint& Hint)
+{
+    // Only show hints for the board as it is now
+    if (Hint.StateVersion == Game->GetStateVersion())
+    {
+        CurrentHint = Hint;
+    }
+}
+
+FLinearColor SMinesweeperWindow::GetTileHintColor(int32 X, int32 Y) const
+{
+    if (X != CurrentHint.X || Y != CurrentHint.Y)
+    {
+        return FLinearColor::Transparent;
+    }
+    
+    // Green for a tile proven safe, amber for the best guess
+    return CurrentHint.bSafe ? FLinearColor(0.1f, 0.8f, 0.1f, 0.5f) : FLinearColor(1.0f, 0.7f, 0.0f, 0.5f);
+}
+
+FReply SMinesweeperWindow::OnStressClicked()
+{
+    if (IsStressRunning())
+    {
+        StopStress();
+        return FReply::Handled();
+    }
+    
+    // Stress games are neither recorded nor hinted, so neither disk writes nor background solves skew the frames
+    ReplayPlayer.Reset();
+    PlaybackKeyframes = FMinesweeperReplayKeyframes();
+    Recorder.End();
+    CurrentHint = FMinesweeperHint();
+    HintService.Cancel();
+    
+    bShowStressReport = false;
+    StressGamesLeft = StressGames;
+    StressProfiler.Begin();
+    StartStressGame();
+    RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SMinesweeperWindow::TickStress));
+    
+    return FReply::Handled();
+}
+
+void SMinesweeperWindow::StartStressGame()
+{
+    Game->NewGame(WidthSpinBox->GetValue(), HeightSpinBox->GetValue(), BombCountSpinBox->GetValue());
+    UpdateGameGrid();
+    UpdateGameStatus();
+    StressProfiler.SampleWidgetCount(SharedThis(this));
+}
+
+EActiveTimerReturnType SMinesweeperWindow::TickStress(double InCurrentTime, float InDeltaTime)
+{
+    if (!IsStressRunning())
+    {
+        return EActiveTimerReturnType::Stop;
+    }
+    
+    StressProfiler.AddFrame(InDeltaTime);
+    
+    if (Game->IsGameOver() || Game->IsGameWon())
+    {
+        if (--StressGamesLeft <= 0)
+        {
+            StopStress();
+            return EActiveTimerReturnType::Stop;
+        }
+        StartStressGame();
+        return EActiveTimerReturnType::Continue;
+    }
+    
+    // One bot step a frame: open the middle, then reveal every tile logic proves safe, or
+    // the least risky one when it is stuck
+    StressActions.Reset();
+    if (Game->GetMoveCount() == 0)
+    {
+        StressActions.Add(FMinesweeperGame::FAction{ FMinesweeperGame::EActionType::Reveal, Game->GetWidth() / 2, Game->GetHeight() / 2 });
+    }
+    else
+    {
+        FMinesweeperSolver::MakeView(*Game, StressView);
+        StressSafeTiles.Reset();
+        if (!StressSolver.Solve(StressView, StressSafeTiles))
+        {
+            StressSafeTiles.Add(StressSolver.FindLowestRiskTile(StressView));
+        }
+        for (const int32 TileIndex : StressSafeTiles)
+        {
+            if (TileIndex != INDEX_NONE)
+            {
+                StressActions.Add(FMinesweeperGame::FAction{ FMinesweeperGame::EActionType::Reveal, TileIndex % StressView.Width, TileIndex / StressView.Width });
+            }
+        }
+    }
+    Game->ApplyActions(StressActions);
+    UpdateGameStatus();
+    
+    return EActiveTimerReturnType::Continue;
+}
+
+void SMinesweeperWindow::StopStress()
+{
+    StressProfiler.End();
+    
+    const FString Report = FString::Printf(TEXT("Stress: %d games of %dx%d with %d bombs\n%s"),
+        StressGames - FMath::Max(StressGamesLeft, 0), Game->GetWidth(), Game->GetHeight(), Game->GetBombCount(), *StressProfiler.BuildReport());
+    UE_LOG(LogMinesweeperWindow, Log, TEXT("%s"), *Report);
+    
+    StressReportText->SetText(FText::FromString(Report));
+    bShowStressReport = true;
+    
+    // Auto hints pick up again from the last stress board
+    RefreshHint();
+}
+
+FText SMinesweeperWindow::GetStressButtonText() const
+{
+    return IsStressRunning() ? LOCTEXT("StopStressButton", "Stop Stress") : LOCTEXT("StressButton", "Stress");
+}
+
+int32 SMinesweeperWindow::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
+    const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements,
+    int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    // Painting is recursive, so this times the whole window, board included
+    const double PaintStart = FPlatformTime::Seconds();
+    const int32 MaxLayerId = SCompoundWidget::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+    StressProfiler.AddPaintTime(FPlatformTime::Seconds() - PaintStart);
+    
+    // The click's result has now been drawn into this frame
+    FMinesweeperInputLatency::Get().OnPainted(*Game);
+    return MaxLayerId;
+}
+
+FString SMinesweeperWindow::GetLastGameReplayPath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("Minesweeper/Replays/LastGame.msreplay");
+}
+
 TSharedRef<SWidget> SMinesweeperWindow::BuildConfigPanel()
 {
     return SNew(SBorder)
@@ -192,6 +595,74 @@ TSharedRef<SWidget> SMinesweeperWindow::BuildConfigPanel()
                 .Text(LOCTEXT("NewGameButton", "New Game"))
                 .OnClicked(this, &SMinesweeperWindow::OnNewGameClicked)
             ]
+            
+            // Replay Button
+            + SHorizontalBox::Slot()
+            .Padding(4, 0)
+            .AutoWidth()
+            .VAlign(VAlign_Bottom)
+            [
+                SAssignNew(ReplayButton, SButton)
+                .Text(LOCTEXT("ReplayButton", "Replay"))
+                .ToolTipText(LOCTEXT("ReplayButtonTooltip", "Watch the last game again at its original speed"))
+                .OnClicked(this, &SMinesweeperWindow::OnReplayClicked)
+            ]
+            
+            // Hint Button
+            + SHorizontalBox::Slot()
+            .Padding(4, 0)
+            .AutoWidth()
+            .VAlign(VAlign_Bottom)
+            [
+                SNew(SButton)
+                .Text(LOCTEXT("HintButton", "Hint"))
+                .ToolTipText(LOCTEXT("HintButtonTooltip", "Highlight a safe tile, or the least risky one if logic cannot find one"))
+                .OnClicked(this, &SMinesweeperWindow::OnHintClicked)
+            ]
+            
+            // Auto Hint Toggle
+            + SHorizontalBox::Slot()
+            .Padding(4, 0)
+            .AutoWidth()
+            .VAlign(VAlign_Bottom)
+            [
+                SNew(SCheckBox)
+                .IsChecked(this, &SMinesweeperWindow::GetAutoHintState)
+                .OnCheckStateChanged(this, &SMinesweeperWindow::OnAutoHintChanged)
+                .ToolTipText(LOCTEXT("AutoHintTooltip", "Work out a hint in the background after every move"))
+                [
+                    SNew(STextBlock)
+                    .Text(LOCTEXT("AutoHintLabel", "Auto Hint"))
+                ]
+            ]
+            
+            // Latency Overlay Toggle
+            + SHorizontalBox::Slot()
+            .Padding(4, 0)
+            .AutoWidth()
+            .VAlign(VAlign_Bottom)
+            [
+                SNew(SCheckBox)
+                .IsChecked(this, &SMinesweeperWindow::GetShowLatencyState)
+                .OnCheckStateChanged(this, &SMinesweeperWindow::OnShowLatencyChanged)
+                .ToolTipText(LOCTEXT("LatencyTooltip", "Show how long clicks on this board size take to reach the screen. Minesweeper.Latency.Dump writes every board size to CSV."))
+                [
+                    SNew(STextBlock)
+                    .Text(LOCTEXT("LatencyLabel", "Latency"))
+                ]
+            ]
+            
+            // Stress Button
+            + SHorizontalBox::Slot()
+            .Padding(4, 0)
+            .AutoWidth()
+            .VAlign(VAlign_Bottom)
+            [
+                SNew(SButton)
+                .Text(this, &SMinesweeperWindow::GetStressButtonText)
+                .ToolTipText(LOCTEXT("StressButtonTooltip", "Let a bot play 20 games on this board size as fast as the editor draws them, then report frame times, Slate paint time and widget count"))
+                .OnClicked(this, &SMinesweeperWindow::OnStressClicked)
+            ]
         ];
 }
 
@@ -214,26 +685,51 @@ TSharedRef<SWidget> SMinesweeperWindow::BuildGameGrid()
 
 void SMinesweeperWindow::UpdateGameGrid()
 {
-    // Clear existing grid
-    GameGrid->ClearChildren();
-    
     // Get game dimensions
     const int32 Width = Game->GetWidth();
     const int32 Height = Game->GetHeight();
     
-    // Create a grid of tile widgets
+    // Tiles read their state from the game, so a board of the same size keeps every widget as it is
+    if (Width == GridWidth && Height == GridHeight)
+    {
+        return;
+    }
+    GridWidth = Width;
+    GridHeight = Height;
+    
+    // Grow or shrink the pool to the new tile count
+    const int32 NumTiles = Width * Height;
+    if (TilePool.Num() < NumTiles)
+    {
+        UE_LOG(LogMinesweeperWindow, Verbose, TEXT("Creating %d tile widgets for a %dx%d board"), NumTiles - TilePool.Num(), Width, Height);
+        TilePool.Reserve(NumTiles);
+        while (TilePool.Num() < NumTiles)
+        {
+            TilePool.Add(SNew(SMinesweeperTile).Game(Game));
+        }
+    }
+    else if (TilePool.Num() > NumTiles)
+    {
+        TilePool.RemoveAt(NumTiles, TilePool.Num() - NumTiles);
+    }
+    
+    // Lay the pooled tiles out again, row by row
+    GameGrid->ClearChildren();
     for (int32 Y = 0; Y < Height; ++Y)
     {
         for (int32 X = 0; X < Width; ++X)
         {
+            const TSharedRef<SMinesweeperTile>& Tile = TilePool[Y * Width + X];
+            Tile->Rebind(X, Y,
+                FOnClicked::CreateSP(this, &SMinesweeperWindow::OnTileClicked, X, Y),
+                FOnClicked::CreateSP(this, &SMinesweeperWindow::OnTileRightClicked, X, Y),
+                FOnClicked::CreateSP(this, &SMinesweeperWindow::OnTileChorded, X, Y),
+                MakeAttributeSP(this, &SMinesweeperWindow::GetTileHintColor, X, Y));
+            
             GameGrid->AddSlot(X, Y)
             .Padding(2)  // Increased padding between tiles
             [
-                SNew(SMinesweeperTile)
-                .X(X)
-                .Y(Y)
-                .Game(Game)
-                .OnTileClicked(this, &SMinesweeperWindow::OnTileClicked, X, Y)
+                Tile
             ];
         }
     }
@@ -253,7 +749,10 @@ void SMinesweeperWindow::UpdateGameStatus()
     }
     else
     {
-        GameStatusText->SetText(LOCTEXT("PlayingStatus", "Playing..."));
+        GameStatusText->SetText(FText::Format(IsReplayPlaying()
+            ? LOCTEXT("ReplayingStatus", "Replaying... Mines left: {0}")
+            : LOCTEXT("PlayingStatus", "Playing... Mines left: {0}"),
+            FText::AsNumber(Game->GetRemainingMines())));
         GameStatusText->SetColorAndOpacity(FLinearColor::White);
     }
 }
@@ -0,0 +1,53 @@
+// MinesweeperFrameProfiler.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class SWidget;
+class SWindow;
+
+// Collects editor frame timings while the UI is stress-tested: the time between frames, the
+// time Slate takes after its tick to prepass and paint every window, the paint time of the
+// widget under test, and how many widgets it holds. Everything happens on the game thread.
+class FMinesweeperFrameProfiler
+{
+public:
+	~FMinesweeperFrameProfiler();
+
+	void Begin();
+	void End();
+	bool IsRunning() const { return bRunning; }
+
+	// Called by the widget under test, once per frame and from its OnPaint
+	void AddFrame(float DeltaSeconds);
+	void AddPaintTime(double Seconds);
+
+	// Count the widgets under Root, keeping the peak
+	void SampleWidgetCount(const TSharedRef<SWidget>& Root);
+
+	// Average, p95 and p99 of every timing, one line each
+	FString BuildReport() const;
+
+private:
+	void OnPostTick(float DeltaSeconds);
+	void OnWindowRendered(SWindow& Window, void* ViewportRHI);
+
+	static int32 CountWidgets(const TSharedRef<SWidget>& Widget);
+
+	TArray<float> FrameSeconds;
+	TArray<float> DrawSeconds;
+	TArray<float> PaintSeconds;
+
+	// When Slate finished ticking this frame and when it last finished rendering a window
+	double PostTickTime = 0.0;
+	double LastRenderedTime = 0.0;
+
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+	int32 LastWidgetCount = 0;
+	int32 PeakWidgetCount = 0;
+	bool bRunning = false;
+
+	FDelegateHandle PostTickHandle;
+	FDelegateHandle WindowRenderedHandle;
+};
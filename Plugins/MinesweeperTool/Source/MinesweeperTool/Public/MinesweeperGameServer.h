@@ -0,0 +1,102 @@
+// MinesweeperGameServer.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HttpRouteHandle.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "MinesweeperGame.h"
+#include <atomic>
+
+class IHttpRouter;
+
+// Localhost HTTP/JSON server hosting many games at once, for bots. Routes:
+//   POST   /minesweeper/games                  {"width", "height", "bombs", "seed"?} -> {"id", "width", "height", "bombs", "seed"}
+//   POST   /minesweeper/games/:id/actions      {"actions": [{"type": "reveal"|"flag"|"chord", "x", "y"}]} -> delta of the batch
+//   GET    /minesweeper/games/:id/delta?since=N -> every change after version N
+//   DELETE /minesweeper/games/:id
+// A delta is {"version", "revealed": [tile], "values": [adjacent bombs, or -2 for a mine], "flagged": [tile],
+// "unflagged": [tile], "gameOver", "won", "remainingMines"}, with tiles as Y * Width + X.
+//
+// Parsing and play run in the shared thread pool. Sessions are split across shards by id, and
+// each shard has its own lock, so requests for games on different shards never wait on each
+// other's lock. Shards do not get their own workers, though: every request is queued on the same
+// pool. Each request also passes through the game thread twice. The HTTPServer listener reads
+// requests on the game thread's tick, and each response is handed back there to be written. So
+// throughput is bounded by the editor's frame rate, and a throttled background editor is slow.
+class MINESWEEPERTOOL_API FMinesweeperGameServer : public TSharedFromThis<FMinesweeperGameServer, ESPMode::ThreadSafe>
+{
+public:
+	static constexpr uint32 DefaultPort = 8790;
+
+	// Requests per second the server should sustain for a fleet of 64 bots on expert boards.
+	// Minesweeper.Server.Bench reports against it, along with the frame rate the run got.
+	static constexpr double TargetRequestsPerSecond = 2000.0;
+
+	// Limits that keep a misbehaving client from exhausting the editor's memory
+	static constexpr int32 MaxSessions = 4096;
+	static constexpr int32 MaxBoardTiles = 1000 * 1000;
+	static constexpr int32 MaxActionsPerRequest = 4096;
+
+	explicit FMinesweeperGameServer(int32 NumShards);
+	~FMinesweeperGameServer();
+
+	// Bind the routes on a listener restricted to 127.0.0.1. Call on the game thread.
+	bool Start(uint32 InPort = DefaultPort);
+
+	// Unbind the routes and drop every session. Requests already in flight still complete.
+	void Stop();
+
+	bool IsRunning() const { return Router.IsValid(); }
+	uint32 GetPort() const { return Port; }
+	int32 GetNumShards() const { return Shards.Num(); }
+	int32 GetNumSessions() const { return NumSessions; }
+
+private:
+	// A hosted game and the order its tiles changed in, so any earlier version can be caught up.
+	// Version N is the state after N moves that changed the board.
+	struct FSession
+	{
+		FMinesweeperGame Game;
+		TArray<int32> RevealedTiles;
+		TArray<int32> FlagTiles;
+
+		// Where each version ends in RevealedTiles and FlagTiles
+		TArray<int32> RevealedEnds;
+		TArray<int32> FlagEnds;
+
+		int32 GetVersion() const { return RevealedEnds.Num(); }
+	};
+
+	struct FShard
+	{
+		FCriticalSection Lock;
+		TMap<int32, TUniquePtr<FSession>> Sessions;
+	};
+
+	// Route handlers, run in the thread pool. Each fills the JSON body and returns the status.
+	typedef EHttpServerResponseCodes (FMinesweeperGameServer::*FRouteHandler)(const FHttpServerRequest& Request, FString& OutJson);
+	EHttpServerResponseCodes HandleCreateGame(const FHttpServerRequest& Request, FString& OutJson);
+	EHttpServerResponseCodes HandleApplyActions(const FHttpServerRequest& Request, FString& OutJson);
+	EHttpServerResponseCodes HandleGetDelta(const FHttpServerRequest& Request, FString& OutJson);
+	EHttpServerResponseCodes HandleDeleteGame(const FHttpServerRequest& Request, FString& OutJson);
+
+	void BindRoute(const TCHAR* Path, EHttpServerRequestVerbs Verb, FRouteHandler Handler);
+
+	// The shard a session id belongs to, and the id itself from the route, or INDEX_NONE
+	FShard& GetShard(int32 SessionId) { return Shards[SessionId % Shards.Num()]; }
+	static int32 GetSessionId(const FHttpServerRequest& Request);
+
+	// Write the changes a session made after SinceVersion, and "applied" unless NumApplied is
+	// INDEX_NONE. Call with the session's shard locked.
+	static void WriteDelta(const FSession& Session, int32 SinceVersion, int32 NumApplied, FString& OutJson);
+
+	// Shards are allocated once, so their locks never move
+	TArray<FShard> Shards;
+	std::atomic<int32> NextSessionId;
+	std::atomic<int32> NumSessions;
+
+	TSharedPtr<IHttpRouter> Router;
+	TArray<FHttpRouteHandle> RouteHandles;
+	uint32 Port;
+};
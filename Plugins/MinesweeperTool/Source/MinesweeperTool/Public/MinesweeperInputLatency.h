@@ -0,0 +1,98 @@
+// MinesweeperInputLatency.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FMinesweeperGame;
+
+// Click-to-paint timing costs four cycle counter reads per click, so it stays on outside shipping builds
+#ifndef MINESWEEPER_INPUT_LATENCY
+	#define MINESWEEPER_INPUT_LATENCY !UE_BUILD_SHIPPING
+#endif
+
+// Times each click on the board from the tile's pointer event to the first paint of the window
+// that shows its result, in three spans: the engine applying the move, the window publishing it
+// (status, hint request, replay log) and Slate getting it on screen. The last 512 clicks on each
+// board size are kept for a rolling histogram. A click that changes nothing is not timed, and a
+// click made before the previous one was painted replaces it. Game thread only.
+class FMinesweeperInputLatency
+{
+public:
+	static constexpr int32 SamplesPerBoard = 512;
+
+	static FMinesweeperInputLatency& Get();
+
+#if MINESWEEPER_INPUT_LATENCY
+	void OnInput(const FMinesweeperGame& Game);
+	void OnApplied(const FMinesweeperGame& Game);
+	void OnPublished();
+	void OnPainted(const FMinesweeperGame& Game);
+#else
+	void OnInput(const FMinesweeperGame& Game) {}
+	void OnApplied(const FMinesweeperGame& Game) {}
+	void OnPublished() {}
+	void OnPainted(const FMinesweeperGame& Game) {}
+#endif
+
+	// Bumped by every recorded click, so a display can tell when to redraw
+	uint64 GetRevision() const { return Revision; }
+
+	// Percentiles, the mean of each span and the histogram for one board size, a few lines long
+	FString Describe(int32 Width, int32 Height) const;
+
+	// One row per board size: clicks, percentiles and histogram bucket counts
+	bool DumpCsv(const FString& Filename) const;
+
+private:
+	enum class EStage : uint8
+	{
+		Idle,
+		Input,
+		Applied,
+		Published
+	};
+
+	// Milliseconds spent in each span of one click
+	struct FSample
+	{
+		float Apply;
+		float Publish;
+		float Paint;
+
+		float GetTotal() const { return Apply + Publish + Paint; }
+	};
+
+	struct FBoardSamples
+	{
+		TArray<FSample> Samples;
+		int32 NextSample = 0;
+		int64 TotalClicks = 0;
+	};
+
+	// Histogram bucket upper bounds in milliseconds; the last bucket takes the rest
+	static constexpr int32 NumBuckets = 9;
+	static const float BucketLimits[NumBuckets - 1];
+
+	struct FSummary
+	{
+		int32 Count = 0;
+		float P50 = 0.0f;
+		float P95 = 0.0f;
+		float P99 = 0.0f;
+		FSample Mean = { 0.0f, 0.0f, 0.0f };
+		int32 Buckets[NumBuckets] = {};
+	};
+	static FSummary Summarize(const FBoardSamples& Board);
+
+	TMap<FIntPoint, FBoardSamples> Boards;
+	uint64 Revision = 0;
+
+	// The click in flight
+	EStage Stage = EStage::Idle;
+	uint64 InputVersion = 0;
+	uint64 AppliedVersion = 0;
+	uint64 InputCycles = 0;
+	uint64 AppliedCycles = 0;
+	uint64 PublishedCycles = 0;
+	FIntPoint BoardSize = FIntPoint::ZeroValue;
+};
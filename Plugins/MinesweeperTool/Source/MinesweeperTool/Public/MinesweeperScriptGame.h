@@ -0,0 +1,104 @@
+// MinesweeperScriptGame.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "MinesweeperGame.h"
+#include "MinesweeperScriptGame.generated.h"
+
+UENUM(BlueprintType)
+enum class EMinesweeperActionType : uint8
+{
+	Reveal,
+	Flag,
+	Chord
+};
+
+USTRUCT(BlueprintType)
+struct FMinesweeperScriptAction
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minesweeper")
+	EMinesweeperActionType Type = EMinesweeperActionType::Reveal;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minesweeper")
+	int32 X = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minesweeper")
+	int32 Y = 0;
+};
+
+// Everything a batch of actions changed, with tiles indexed Y * Width + X
+USTRUCT(BlueprintType)
+struct FMinesweeperScriptDelta
+{
+	GENERATED_BODY()
+
+	// Actions that changed the board; 0 if the batch was rejected
+	UPROPERTY(BlueprintReadOnly, Category = "Minesweeper")
+	int32 NumApplied = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Minesweeper")
+	TArray<int32> RevealedTiles;
+
+	// Tiles whose flag was toggled
+	UPROPERTY(BlueprintReadOnly, Category = "Minesweeper")
+	TArray<int32> FlaggedTiles;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Minesweeper")
+	bool bGameOver = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Minesweeper")
+	bool bGameWon = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Minesweeper")
+	int32 RemainingMines = 0;
+};
+
+/**
+ * A game for Python and editor utility scripts. Bots hand over a whole batch of actions per
+ * call, so playing a move does not cross the reflection boundary once per tile.
+ */
+UCLASS(BlueprintType)
+class MINESWEEPERTOOL_API UMinesweeperScriptGame : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Minesweeper")
+	void NewGame(int32 Width, int32 Height, int32 BombCount, int32 Seed);
+
+	// Apply the actions in order as one move; see FMinesweeperGame::ApplyActions
+	UFUNCTION(BlueprintCallable, Category = "Minesweeper")
+	FMinesweeperScriptDelta ApplyActions(const TArray<FMinesweeperScriptAction>& Actions);
+
+	// What the player sees, indexed Y * Width + X: the adjacent count of revealed tiles,
+	// HiddenTile, FlaggedTile or MineTile
+	UFUNCTION(BlueprintCallable, Category = "Minesweeper")
+	TArray<int32> GetVisibleBoard() const;
+
+	UFUNCTION(BlueprintPure, Category = "Minesweeper")
+	int32 GetWidth() const { return Game.GetWidth(); }
+
+	UFUNCTION(BlueprintPure, Category = "Minesweeper")
+	int32 GetHeight() const { return Game.GetHeight(); }
+
+	UFUNCTION(BlueprintPure, Category = "Minesweeper")
+	int32 GetRemainingMines() const { return Game.GetRemainingMines(); }
+
+	UFUNCTION(BlueprintPure, Category = "Minesweeper")
+	bool IsGameOver() const { return Game.IsGameOver(); }
+
+	UFUNCTION(BlueprintPure, Category = "Minesweeper")
+	bool IsGameWon() const { return Game.IsGameWon(); }
+
+	static constexpr int32 HiddenTile = -1;
+	static constexpr int32 MineTile = -2;
+	static constexpr int32 FlaggedTile = -3;
+
+	FMinesweeperGame& GetGame() { return Game; }
+
+private:
+	FMinesweeperGame Game;
+};
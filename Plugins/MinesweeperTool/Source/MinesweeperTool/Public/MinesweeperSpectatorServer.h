@@ -0,0 +1,74 @@
+// MinesweeperSpectatorServer.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "HAL/CriticalSection.h"
+#include "MinesweeperGame.h"
+#include <atomic>
+
+class FSocket;
+class FTcpListener;
+struct FIPv4Endpoint;
+
+// Streams a game to viewers on this machine over TCP on 127.0.0.1, as back-to-back
+// FMinesweeperDelta messages starting with a keyframe. A sender thread polls the game's read
+// snapshots and gives each viewer the delta from the state it last received to the latest one,
+// but only once the socket has taken all of its previous message. A slow viewer therefore gets
+// fewer, larger deltas instead of a growing backlog, and holds at most one message in memory.
+class MINESWEEPERTOOL_API FMinesweeperSpectatorServer
+{
+public:
+	static constexpr uint32 DefaultPort = 8791;
+	static constexpr int32 MaxViewers = 64;
+
+	// How often the sender looks for a new state while every viewer is caught up
+	static constexpr float PollSeconds = 1.0f / 120.0f;
+
+	FMinesweeperSpectatorServer();
+	~FMinesweeperSpectatorServer();
+
+	bool Start(uint32 InPort = DefaultPort);
+	void Stop();
+
+	bool IsRunning() const { return Listener.IsValid(); }
+	uint32 GetPort() const { return Port; }
+	int32 GetNumViewers() const { return NumViewers; }
+
+	// The game to stream. Viewers get a keyframe of the new game. Safe to call from any thread.
+	void SetSource(TSharedPtr<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> InSource);
+
+private:
+	struct FViewer
+	{
+		FSocket* Socket = nullptr;
+
+		// The state the viewer will be at once Message has been sent
+		TSharedPtr<const FMinesweeperGame, ESPMode::ThreadSafe> State;
+
+		// The message being sent, shared by viewers that were at the same state
+		TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> Message;
+		int32 MessageOffset = 0;
+	};
+
+	// Called on the listener's thread
+	bool OnConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint);
+
+	void RunSender();
+
+	// Send as much of the viewer's message as the socket takes; false once the viewer has gone
+	static bool SendPending(FViewer& Viewer);
+	static void CloseSocket(FSocket* Socket);
+
+	TUniquePtr<FTcpListener> Listener;
+	TFuture<void> Sender;
+	std::atomic<bool> bStopping;
+	std::atomic<int32> NumViewers;
+	uint32 Port;
+
+	// Handed from other threads to the sender
+	FCriticalSection Lock;
+	TArray<FSocket*> AcceptedSockets;
+	TSharedPtr<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> Source;
+	bool bSourceChanged;
+};
@@ -4,10 +4,13 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 #include "Toolkits/AssetEditorToolkit.h"
+#include "MinesweeperGame.h"
 
 class FToolBarBuilder;
 class FMenuBuilder;
 class SDockTab;
+class FMinesweeperGameServer;
+class FMinesweeperSpectatorServer;
 
 class FMinesweeperToolModule : public IModuleInterface
 {
@@ -18,10 +21,25 @@ public:
     
 	// Callback for when the minesweeper button is clicked
 	void PluginButtonClicked();
+
+	static FMinesweeperToolModule& Get() { return FModuleManager::GetModuleChecked<FMinesweeperToolModule>("MinesweeperTool"); }
+
+	// The HTTP server bots play on; see FMinesweeperGameServer. Starting replaces a running server.
+	bool StartGameServer(uint32 Port, int32 NumShards);
+	void StopGameServer();
+	TSharedPtr<FMinesweeperGameServer, ESPMode::ThreadSafe> GetGameServer() const { return GameServer; }
+
+	// The delta stream spectators watch; see FMinesweeperSpectatorServer. Starting replaces a running server.
+	bool StartSpectatorServer(uint32 Port);
+	void StopSpectatorServer();
+
+	// The game spectators see, kept while the server is stopped
+	void SetSpectatedGame(TSharedPtr<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> Source);
     
 private:
 	// Register and create the plugin UI
 	void RegisterMenus();
+	void InitializeOnFirstOpen();
 	TSharedRef<SDockTab> OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs);
 	void OnPluginTabClosed(TSharedRef<SDockTab> TabClosed);
     
@@ -30,4 +48,12 @@ private:
     
 	// Keep track of the opened tab
 	TSharedPtr<SDockTab> MinesweeperTab;
+
+	// Set once the tab has been spawned and the commands registered
+	bool bInitialized = false;
+
+	TSharedPtr<FMinesweeperGameServer, ESPMode::ThreadSafe> GameServer;
+
+	TUniquePtr<FMinesweeperSpectatorServer> SpectatorServer;
+	TSharedPtr<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> SpectatedGame;
 };
\ No newline at end of file
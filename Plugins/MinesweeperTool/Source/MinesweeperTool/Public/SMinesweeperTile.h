@@ -13,15 +13,26 @@ public:
 		, _Y(0)
 		, _Game(nullptr)
 		, _OnTileClicked()
+		, _OnTileRightClicked()
+		, _OnTileChorded()
+		, _HintColor(FLinearColor::Transparent)
 	{}
 	SLATE_ARGUMENT(int32, X)
 	SLATE_ARGUMENT(int32, Y)
 	SLATE_ARGUMENT(TSharedPtr<FMinesweeperGame>, Game)
 	SLATE_EVENT(FOnClicked, OnTileClicked)
+	SLATE_EVENT(FOnClicked, OnTileRightClicked)
+	SLATE_EVENT(FOnClicked, OnTileChorded)
+	// Overlay for a hinted tile; transparent when the tile is not hinted
+	SLATE_ATTRIBUTE(FLinearColor, HintColor)
 SLATE_END_ARGS()
 
  void Construct(const FArguments& InArgs);
 
+	// Moves a pooled tile to another cell of the board, with events bound for that cell
+	void Rebind(int32 InX, int32 InY, const FOnClicked& InOnTileClicked, const FOnClicked& InOnTileRightClicked,
+		const FOnClicked& InOnTileChorded, const TAttribute<FLinearColor>& InHintColor);
+
 	// SWidget interface
 	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, 
@@ -34,6 +45,9 @@ SLATE_END_ARGS()
 	int32 Y;
 	TSharedPtr<FMinesweeperGame> Game;
 	FOnClicked OnTileClicked;
+	FOnClicked OnTileRightClicked;
+	FOnClicked OnTileChorded;
+	TAttribute<FLinearColor> HintColor;
     
 	FSlateColor GetTileColor() const;
 	FText GetTileText() const;
@@ -4,11 +4,17 @@
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "MinesweeperGame.h"
+#include "MinesweeperReplay.h"
+#include "MinesweeperHintService.h"
+#include "MinesweeperSolver.h"
+#include "MinesweeperFrameProfiler.h"
 #include "Widgets/Input/SSpinBox.h"
 
 
 class SButton;
 class SGridPanel;
+class SMinesweeperTile;
+class SSlider;
 class STextBlock;
 
 class SMinesweeperWindow : public SCompoundWidget
@@ -20,21 +26,103 @@ public:
 
 	void Construct(const FArguments& InArgs);
 
+	// SWidget interface
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
+						const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements,
+						int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	// End of SWidget interface
+
 private:
 	// Game state
 	TSharedPtr<FMinesweeperGame> Game;
+
+	// Every game is recorded so it can be watched back or re-run headless
+	FMinesweeperReplayRecorder Recorder;
+	FMinesweeperReplay PlaybackReplay;
+	FMinesweeperReplayKeyframes PlaybackKeyframes;
+	TUniquePtr<FMinesweeperReplayPlayer> ReplayPlayer;
+	double PlaybackStartTime = 0.0;
+	double PlaybackPositionSeconds = 0.0;
+	bool bReplayTimerActive = false;
+
+	// Hints are worked out in the background from read snapshots of the game
+	TSharedPtr<FMinesweeperGame::FReadSnapshotSource, ESPMode::ThreadSafe> ReadSnapshots;
+	FMinesweeperHintService HintService;
+	FMinesweeperHint CurrentHint;
+	bool bAutoHint = false;
+
+	// Stress mode: a solver bot plays StressGames games on the configured board, one step a
+	// frame, while the profiler times the editor's frames
+	static constexpr int32 StressGames = 20;
+	mutable FMinesweeperFrameProfiler StressProfiler;
+	FMinesweeperSolver StressSolver;
+	FMinesweeperSolver::FBoardView StressView;
+	TArray<int32> StressSafeTiles;
+	TArray<FMinesweeperGame::FAction> StressActions;
+	int32 StressGamesLeft = 0;
+	bool bShowStressReport = false;
+
+	// Click-to-paint latency overlay; its text is rebuilt only when a new click is recorded
+	bool bShowLatency = false;
+	mutable FText LatencyText;
+	mutable uint64 LatencyTextRevision = 0;
+	mutable FIntPoint LatencyTextBoardSize = FIntPoint::ZeroValue;
     
 	// UI References
 	TSharedPtr<SSpinBox<int32>> WidthSpinBox;
 	TSharedPtr<SSpinBox<int32>> HeightSpinBox;
 	TSharedPtr<SSpinBox<int32>> BombCountSpinBox;
 	TSharedPtr<SButton> NewGameButton;
+	TSharedPtr<SButton> ReplayButton;
 	TSharedPtr<SGridPanel> GameGrid;
 	TSharedPtr<STextBlock> GameStatusText;
+	TSharedPtr<SSlider> ReplayTimeline;
+	TSharedPtr<STextBlock> StressReportText;
+
+	// Tile widgets are kept across games and only created or released when the board size
+	// changes; GridWidth and GridHeight are the size they are laid out for
+	TArray<TSharedRef<SMinesweeperTile>> TilePool;
+	int32 GridWidth = 0;
+	int32 GridHeight = 0;
     
 	// Event handlers
 	FReply OnNewGameClicked();
 	FReply OnTileClicked(int32 X, int32 Y);
+	FReply OnTileRightClicked(int32 X, int32 Y);
+	FReply OnTileChorded(int32 X, int32 Y);
+	FReply OnReplayClicked();
+	FReply OnHintClicked();
+	void OnAutoHintChanged(ECheckBoxState NewState);
+	ECheckBoxState GetAutoHintState() const { return bAutoHint ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; }
+
+	// Hints. Every change to the board drops the shown hint and cancels the one being worked
+	// out; with auto hints on, the next one is requested straight away.
+	void RequestHint();
+	void RefreshHint();
+	void OnHintReady(const FMinesweeperHint& Hint);
+	FLinearColor GetTileHintColor(int32 X, int32 Y) const;
+
+	// Replay playback. The board shows the replay, not a live game, until the next New Game.
+	EActiveTimerReturnType TickReplay(double InCurrentTime, float InDeltaTime);
+	bool IsReplayPlaying() const { return ReplayPlayer.IsValid(); }
+	float GetReplayTimelineValue() const;
+	void OnReplayTimelineScrubbed(float NewValue);
+	static FString GetLastGameReplayPath();
+
+	// Stress mode. Clicks on the board are ignored while it runs; New Game stops it.
+	FReply OnStressClicked();
+	EActiveTimerReturnType TickStress(double InCurrentTime, float InDeltaTime);
+	void StartStressGame();
+	void StopStress();
+	bool IsStressRunning() const { return StressProfiler.IsRunning(); }
+	FText GetStressButtonText() const;
+	EVisibility GetStressReportVisibility() const { return bShowStressReport ? EVisibility::Visible : EVisibility::Collapsed; }
+
+	// Latency overlay
+	void OnShowLatencyChanged(ECheckBoxState NewState);
+	ECheckBoxState GetShowLatencyState() const { return bShowLatency ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; }
+	EVisibility GetLatencyVisibility() const { return bShowLatency ? EVisibility::HitTestInvisible : EVisibility::Collapsed; }
+	FText GetLatencyText() const;
     
 	// UI builders
 	TSharedRef<SWidget> BuildConfigPanel();
@@ -0,0 +1,36 @@
+// MinesweeperBench.cpp
+// Runs MinesweeperCore console commands outside the editor, e.g.
+//   MinesweeperBench Minesweeper.Bench.Layout 4096 3
+// With no arguments it lists the commands the core registers.
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+
+int main(int Argc, char** Argv)
+{
+    const std::map<std::string, FAutoConsoleCommand::FEntry>& Registry = FAutoConsoleCommand::GetRegistry();
+    
+    if (Argc < 2)
+    {
+        printf("Usage: %s <Command> [Args...]\n\nCommands:\n", Argv[0]);
+        for (const auto& Entry : Registry)
+        {
+            printf("  %s\n      %s\n", Entry.first.c_str(), Entry.second.Help);
+        }
+        return 1;
+    }
+    
+    const auto Found = Registry.find(Argv[1]);
+    if (Found == Registry.end())
+    {
+        fprintf(stderr, "Unknown command %s; run without arguments for the list\n", Argv[1]);
+        return 1;
+    }
+    
+    TArray<FString> Args;
+    for (int32 Index = 2; Index < Argc; ++Index)
+    {
+        Args.Add(FString(Argv[Index]));
+    }
+    Found->second.Command.Execute(Args);
+    return 0;
+}
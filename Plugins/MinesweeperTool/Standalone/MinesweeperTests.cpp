@@ -0,0 +1,512 @@
+// MinesweeperTests.cpp
+// Checks of the core engine, run by ctest. Each test is one function; with a test name as the
+// argument only that test runs, otherwise all of them do.
+//   MinesweeperTests UndoRedo
+#include "CoreMinimal.h"
+#include "MinesweeperGame.h"
+#include "MinesweeperBatchGame.h"
+#include "Math/RandomStream.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static int32 GFailures = 0;
+
+// Every operator new in this program is counted while GCountAllocations is set
+static std::atomic<bool> GCountAllocations(false);
+static std::atomic<int64> GAllocations(0);
+
+void* operator new(std::size_t Size)
+{
+    if (GCountAllocations)
+    {
+        GAllocations++;
+    }
+    if (void* Memory = std::malloc(Size ? Size : 1))
+    {
+        return Memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* Memory) noexcept
+{
+    std::free(Memory);
+}
+
+void operator delete(void* Memory, std::size_t) noexcept
+{
+    std::free(Memory);
+}
+
+#define TEST_CHECK(Expr) do { if (!(Expr)) { fprintf(stderr, "  FAILED: %s (%s:%d)\n", #Expr, __FILE__, __LINE__); GFailures++; } } while (0)
+
+static bool TilesEqual(const FMinesweeperGame::FTile& A, const FMinesweeperGame::FTile& B)
+{
+    return A.bIsBomb == B.bIsBomb && A.AdjacentBombs == B.AdjacentBombs && A.State == B.State
+        && A.bIsFlagged == B.bIsFlagged && A.FlaggedNeighbors == B.FlaggedNeighbors;
+}
+
+// Every tile of a board, row-major, for comparing whole boards
+static TArray<FMinesweeperGame::FTile> CaptureTiles(const FMinesweeperGame& Game)
+{
+    TArray<FMinesweeperGame::FTile> Tiles;
+    for (int32 Y = 0; Y < Game.GetHeight(); ++Y)
+    {
+        for (int32 X = 0; X < Game.GetWidth(); ++X)
+        {
+            Tiles.Add(Game.GetTile(X, Y));
+        }
+    }
+    return Tiles;
+}
+
+static bool BoardsEqual(const TArray<FMinesweeperGame::FTile>& A, const TArray<FMinesweeperGame::FTile>& B)
+{
+    if (A.Num() != B.Num())
+    {
+        return false;
+    }
+    for (int32 Index = 0; Index < A.Num(); ++Index)
+    {
+        if (!TilesEqual(A[Index], B[Index]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The same seed and first click give the same board, in either storage layout
+static void TestSeededDeterminism()
+{
+    struct FSize { int32 Width; int32 Height; int32 Bombs; };
+    for (const FSize Size : { FSize{ 9, 9, 10 }, FSize{ 30, 16, 99 }, FSize{ 100, 70, 1000 } })
+    {
+        int32 DistinctBoards = 0;
+        TArray<FMinesweeperGame::FTile> Previous;
+        for (int32 Seed = 1; Seed <= 20; ++Seed)
+        {
+            const int32 FirstX = Seed % Size.Width;
+            const int32 FirstY = (Seed * 7) % Size.Height;
+
+            FMinesweeperGame RowMajor;
+            RowMajor.NewGame(Size.Width, Size.Height, Size.Bombs, Seed);
+            TEST_CHECK(RowMajor.RevealTile(FirstX, FirstY));
+
+            FMinesweeperGame Again;
+            Again.NewGame(Size.Width, Size.Height, Size.Bombs, Seed);
+            Again.RevealTile(FirstX, FirstY);
+
+            FMinesweeperGame Tiled;
+            Tiled.NewGame(Size.Width, Size.Height, Size.Bombs, Seed, FMinesweeperGame::EBoardLayout::Tiled);
+            Tiled.RevealTile(FirstX, FirstY);
+
+            const TArray<FMinesweeperGame::FTile> Tiles = CaptureTiles(RowMajor);
+            TEST_CHECK(BoardsEqual(Tiles, CaptureTiles(Again)));
+            TEST_CHECK(BoardsEqual(Tiles, CaptureTiles(Tiled)));
+
+            // The first click is never a bomb, and the bomb count is exact
+            TEST_CHECK(!RowMajor.GetTile(FirstX, FirstY).bIsBomb);
+            int32 Bombs = 0;
+            for (const FMinesweeperGame::FTile& Tile : Tiles)
+            {
+                Bombs += Tile.bIsBomb;
+            }
+            TEST_CHECK(Bombs == Size.Bombs);
+
+            DistinctBoards += !BoardsEqual(Tiles, Previous);
+            Previous = Tiles;
+        }
+        TEST_CHECK(DistinctBoards == 20);
+    }
+}
+
+// Stepping back through the history restores every earlier board exactly, and stepping
+// forward again replays it
+static void TestUndoRedo()
+{
+    FMinesweeperGame Game;
+    Game.NewGame(30, 16, 60, 7);
+    FRandomStream Random(7);
+
+    TArray<TArray<FMinesweeperGame::FTile>> States;
+    States.Add(CaptureTiles(Game));
+
+    for (int32 Attempt = 0; Attempt < 2000 && States.Num() < 60 && !Game.IsGameWon(); ++Attempt)
+    {
+        const int32 X = Random.RandHelper(Game.GetWidth());
+        const int32 Y = Random.RandHelper(Game.GetHeight());
+        const FMinesweeperGame::FTile Tile = Game.GetTile(X, Y);
+
+        // Safe reveals and flags on mines, so the game never ends by losing
+        bool bChanged;
+        if (Game.GetMoveCount() > 0 && Tile.bIsBomb)
+        {
+            bChanged = Game.ToggleFlag(X, Y);
+        }
+        else
+        {
+            bChanged = Game.RevealTile(X, Y);
+        }
+
+        if (bChanged)
+        {
+            States.Add(CaptureTiles(Game));
+        }
+    }
+    TEST_CHECK(Game.GetUndoDepth() == States.Num() - 1);
+
+    for (int32 Step = States.Num() - 2; Step >= 0; --Step)
+    {
+        TEST_CHECK(Game.Undo());
+        TEST_CHECK(BoardsEqual(CaptureTiles(Game), States[Step]));
+    }
+    TEST_CHECK(!Game.Undo());
+
+    for (int32 Step = 1; Step < States.Num(); ++Step)
+    {
+        TEST_CHECK(Game.Redo());
+        TEST_CHECK(BoardsEqual(CaptureTiles(Game), States[Step]));
+    }
+    TEST_CHECK(!Game.Redo());
+
+    // A new move drops what could have been redone
+    Game.Undo();
+    TEST_CHECK(Game.CanRedo());
+    for (int32 Y = 0; Y < Game.GetHeight() && Game.CanRedo(); ++Y)
+    {
+        for (int32 X = 0; X < Game.GetWidth() && Game.CanRedo(); ++X)
+        {
+            if (Game.GetTile(X, Y).State == FMinesweeperGame::ETileState::Hidden)
+            {
+                Game.ToggleFlag(X, Y);
+            }
+        }
+    }
+    TEST_CHECK(!Game.CanRedo());
+}
+
+// Find a revealed number on a started game with at least one hidden safe neighbor
+static bool FindChordTarget(const FMinesweeperGame& Game, int32& OutX, int32& OutY, int32& OutHiddenSafe)
+{
+    for (int32 Y = 0; Y < Game.GetHeight(); ++Y)
+    {
+        for (int32 X = 0; X < Game.GetWidth(); ++X)
+        {
+            const FMinesweeperGame::FTile Tile = Game.GetTile(X, Y);
+            if (Tile.State != FMinesweeperGame::ETileState::Revealed || Tile.AdjacentBombs == 0)
+            {
+                continue;
+            }
+
+            int32 HiddenSafe = 0;
+            for (int32 DY = -1; DY <= 1; ++DY)
+            {
+                for (int32 DX = -1; DX <= 1; ++DX)
+                {
+                    if ((DX != 0 || DY != 0) && Game.IsValidCoordinate(X + DX, Y + DY))
+                    {
+                        const FMinesweeperGame::FTile Neighbor = Game.GetTile(X + DX, Y + DY);
+                        HiddenSafe += !Neighbor.bIsBomb && Neighbor.State == FMinesweeperGame::ETileState::Hidden;
+                    }
+                }
+            }
+            if (HiddenSafe >= Tile.AdjacentBombs)
+            {
+                OutX = X;
+                OutY = Y;
+                OutHiddenSafe = HiddenSafe;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Flag every neighbor of (X, Y) that is a bomb, or with bWrongFlags, that many safe neighbors instead
+static void FlagAround(FMinesweeperGame& Game, int32 X, int32 Y, bool bWrongFlags)
+{
+    int32 FlagsLeft = Game.GetTile(X, Y).AdjacentBombs;
+    for (int32 DY = -1; DY <= 1; ++DY)
+    {
+        for (int32 DX = -1; DX <= 1; ++DX)
+        {
+            if ((DX != 0 || DY != 0) && Game.IsValidCoordinate(X + DX, Y + DY) && FlagsLeft > 0)
+            {
+                const FMinesweeperGame::FTile Neighbor = Game.GetTile(X + DX, Y + DY);
+                if (Neighbor.State == FMinesweeperGame::ETileState::Hidden && Neighbor.bIsBomb != bWrongFlags)
+                {
+                    TEST_CHECK(Game.ToggleFlag(X + DX, Y + DY));
+                    FlagsLeft--;
+                }
+            }
+        }
+    }
+}
+
+static void TestFlagsAndChords()
+{
+    int32 CheckedSeeds = 0;
+    for (int32 Seed = 1; Seed <= 50 && CheckedSeeds < 10; ++Seed)
+    {
+        FMinesweeperGame Game;
+        Game.NewGame(16, 16, 40, Seed);
+        Game.RevealTile(8, 8);
+
+        int32 X, Y, HiddenSafe;
+        if (Game.IsGameWon() || !FindChordTarget(Game, X, Y, HiddenSafe))
+        {
+            continue;
+        }
+        CheckedSeeds++;
+
+        // Flags only go on hidden tiles, and flagged tiles cannot be revealed
+        TEST_CHECK(!Game.ToggleFlag(X, Y));
+        const int32 AdjacentBombs = Game.GetTile(X, Y).AdjacentBombs;
+
+        // Chording with too few flags does nothing
+        TEST_CHECK(!Game.ChordTile(X, Y));
+
+        FMinesweeperGame Wrong;
+        Wrong.NewGame(16, 16, 40, Seed);
+        Wrong.RevealTile(8, 8);
+
+        FlagAround(Game, X, Y, false);
+        TEST_CHECK(Game.GetFlagCount() == AdjacentBombs);
+        TEST_CHECK(Game.GetRemainingMines() == 40 - AdjacentBombs);
+        TEST_CHECK(Game.GetTile(X, Y).FlaggedNeighbors == AdjacentBombs);
+
+        // A satisfied number reveals every other neighbor
+        TEST_CHECK(Game.ChordTile(X, Y));
+        TEST_CHECK(!Game.IsGameOver());
+        for (int32 DY = -1; DY <= 1; ++DY)
+        {
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                if (Game.IsValidCoordinate(X + DX, Y + DY))
+                {
+                    const FMinesweeperGame::FTile Neighbor = Game.GetTile(X + DX, Y + DY);
+                    TEST_CHECK(Neighbor.bIsBomb ? Neighbor.bIsFlagged : Neighbor.State == FMinesweeperGame::ETileState::Revealed);
+                }
+            }
+        }
+
+        // Unflagging puts the counters back
+        for (int32 DY = -1; DY <= 1; ++DY)
+        {
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                if (Game.IsValidCoordinate(X + DX, Y + DY) && Game.GetTile(X + DX, Y + DY).bIsFlagged)
+                {
+                    TEST_CHECK(!Game.RevealTile(X + DX, Y + DY));
+                    TEST_CHECK(Game.ToggleFlag(X + DX, Y + DY));
+                }
+            }
+        }
+        TEST_CHECK(Game.GetFlagCount() == 0);
+        TEST_CHECK(Game.GetTile(X, Y).FlaggedNeighbors == 0);
+
+        // A wrong flag makes the chord reveal a mine
+        FlagAround(Wrong, X, Y, true);
+        TEST_CHECK(Wrong.ChordTile(X, Y));
+        TEST_CHECK(Wrong.IsGameOver());
+    }
+    TEST_CHECK(CheckedSeeds == 10);
+}
+
+// Board N of a batch plays exactly like a scalar game with the same seed and clicks
+static void TestBatchMatchesScalar()
+{
+    struct FSize { int32 Width; int32 Height; int32 Bombs; };
+    for (const FSize Size : { FSize{ 9, 9, 10 }, FSize{ 16, 16, 40 }, FSize{ 30, 16, 99 }, FSize{ 20, 40, 60 } })
+    {
+        TArray<int32> Seeds;
+        for (int32 Board = 0; Board < FMinesweeperBatchGame::NumBoards; ++Board)
+        {
+            Seeds.Add(Board * 7919 + Size.Width);
+        }
+
+        FMinesweeperBatchGame Batch;
+        Batch.NewGames(Size.Width, Size.Height, Size.Bombs, Seeds);
+        TArray<FMinesweeperGame> Games;
+        for (int32 Board = 0; Board < FMinesweeperBatchGame::NumBoards; ++Board)
+        {
+            Games.AddDefaulted_GetRef().NewGame(Size.Width, Size.Height, Size.Bombs, Seeds[Board]);
+        }
+
+        FRandomStream Random(Size.Bombs);
+        int32 Mismatches = 0;
+        for (int32 Step = 0; Step < 40; ++Step)
+        {
+            // A different click on every board, and some boards sit the step out
+            int32 TileIndices[FMinesweeperBatchGame::NumBoards];
+            for (int32 Board = 0; Board < FMinesweeperBatchGame::NumBoards; ++Board)
+            {
+                TileIndices[Board] = Random.FRand() < 0.1f ? INDEX_NONE : Random.RandHelper(Size.Width * Size.Height);
+                if (TileIndices[Board] != INDEX_NONE)
+                {
+                    Games[Board].RevealTile(TileIndices[Board] % Size.Width, TileIndices[Board] / Size.Width);
+                }
+            }
+            Batch.RevealTiles(MakeArrayView(TileIndices, FMinesweeperBatchGame::NumBoards));
+
+            for (int32 Board = 0; Board < FMinesweeperBatchGame::NumBoards; ++Board)
+            {
+                Mismatches += Batch.IsGameOver(Board) != Games[Board].IsGameOver();
+                Mismatches += Batch.IsGameWon(Board) != Games[Board].IsGameWon();
+                for (int32 Y = 0; Y < Size.Height; ++Y)
+                {
+                    for (int32 X = 0; X < Size.Width; ++X)
+                    {
+                        Mismatches += !TilesEqual(Batch.GetTile(Board, X, Y), Games[Board].GetTile(X, Y));
+                    }
+                }
+            }
+        }
+        TEST_CHECK(Mismatches == 0);
+    }
+}
+
+// A batch that opens an empty tile and then clicks tiles the opening took counts one move
+static void TestBatchedRevealCounts()
+{
+    int32 CheckedSeeds = 0;
+    for (int32 Seed = 1; CheckedSeeds < 10 && Seed < 1000; ++Seed)
+    {
+        // Learn the opening from a game played one click at a time
+        FMinesweeperGame Scalar;
+        Scalar.NewGame(16, 16, 40, Seed);
+        TArray<int32> Opened;
+        Scalar.RevealTile(8, 8, &Opened);
+        if (Scalar.GetTile(8, 8).AdjacentBombs != 0)
+        {
+            continue;
+        }
+        CheckedSeeds++;
+
+        // The empty tile first, then every tile its opening revealed, neighbours and beyond
+        TArray<FMinesweeperGame::FAction> Actions;
+        Actions.Add(FMinesweeperGame::FAction{ FMinesweeperGame::EActionType::Reveal, 8, 8 });
+        for (const int32 Tile : Opened)
+        {
+            if (Tile != 8 * 16 + 8)
+            {
+                Actions.Add(FMinesweeperGame::FAction{ FMinesweeperGame::EActionType::Reveal, Tile % 16, Tile / 16 });
+            }
+        }
+        TEST_CHECK(Actions.Num() > 2);
+
+        FMinesweeperGame Game;
+        Game.NewGame(16, 16, 40, Seed);
+        TArray<int32> Revealed;
+        TEST_CHECK(Game.ApplyActions(Actions, &Revealed) == 1);
+        TEST_CHECK(Game.GetMoveCount() == 1);
+        TEST_CHECK(Revealed.Num() == Opened.Num());
+        TEST_CHECK(BoardsEqual(CaptureTiles(Game), CaptureTiles(Scalar)));
+    }
+    TEST_CHECK(CheckedSeeds == 10);
+}
+
+// One game of safe reveals, flags on mines and chords through ApplyActions, four actions a batch
+static void PlayActionBatches(FMinesweeperGame& Game, int32 Seed, TArray<int32>& Revealed, TArray<int32>& Flagged)
+{
+    FRandomStream Random(Seed);
+    Game.NewGame(Game.GetWidth(), Game.GetHeight(), Game.GetBombCount(), Seed);
+
+    for (int32 Batch = 0; Batch < 4000 && !Game.IsGameOver() && !Game.IsGameWon(); ++Batch)
+    {
+        FMinesweeperGame::FAction Actions[4];
+        for (FMinesweeperGame::FAction& Action : Actions)
+        {
+            Action.X = Random.RandHelper(Game.GetWidth());
+            Action.Y = Random.RandHelper(Game.GetHeight());
+            const FMinesweeperGame::FTile Tile = Game.GetTile(Action.X, Action.Y);
+            if (Game.GetMoveCount() > 0 && Tile.bIsBomb)
+            {
+                Action.Type = Tile.bIsFlagged ? FMinesweeperGame::EActionType::Chord : FMinesweeperGame::EActionType::Flag;
+            }
+            else
+            {
+                Action.Type = Tile.State == FMinesweeperGame::ETileState::Revealed && Tile.FlaggedNeighbors == Tile.AdjacentBombs
+                    ? FMinesweeperGame::EActionType::Chord : FMinesweeperGame::EActionType::Reveal;
+            }
+        }
+
+        Revealed.Reset();
+        Flagged.Reset();
+        Game.ApplyActions(MakeArrayView(Actions, 4), &Revealed, &Flagged);
+    }
+}
+
+// With undo off, a restarted game of the same size plays through ApplyActions without
+// allocating: the board chunks, flood queue and bomb shuffle all reuse what the last game grew
+static void TestAllocationFreeApplyActions()
+{
+    FMinesweeperGame Game;
+    Game.SetUndoEnabled(false);
+    Game.NewGame(300, 200, 300 * 200 / 8, 1);
+
+    TArray<int32> Revealed;
+    TArray<int32> Flagged;
+    Revealed.Reserve(300 * 200);
+    Flagged.Reserve(300 * 200);
+
+    // Warm up: the first game grows every buffer to the board size, and the first restart
+    // grows the list of spare chunks it hands back
+    PlayActionBatches(Game, 1, Revealed, Flagged);
+    PlayActionBatches(Game, 2, Revealed, Flagged);
+
+    for (int32 Seed = 3; Seed <= 6; ++Seed)
+    {
+        GAllocations = 0;
+        GCountAllocations = true;
+        PlayActionBatches(Game, Seed, Revealed, Flagged);
+        GCountAllocations = false;
+
+        TEST_CHECK(Game.GetMoveCount() > 100);
+        TEST_CHECK(GAllocations == 0);
+        if (GAllocations != 0)
+        {
+            fprintf(stderr, "  game %d allocated %lld times\n", Seed, (long long)GAllocations);
+        }
+    }
+}
+
+struct FTest
+{
+    const char* Name;
+    void (*Run)();
+};
+
+static const FTest Tests[] =
+{
+    { "SeededDeterminism", TestSeededDeterminism },
+    { "UndoRedo", TestUndoRedo },
+    { "FlagsAndChords", TestFlagsAndChords },
+    { "BatchMatchesScalar", TestBatchMatchesScalar },
+    { "AllocationFreeApplyActions", TestAllocationFreeApplyActions },
+    { "BatchedRevealCounts", TestBatchedRevealCounts },
+};
+
+int main(int Argc, char** Argv)
+{
+    int32 Ran = 0;
+    for (const FTest& Test : Tests)
+    {
+        if (Argc < 2 || strcmp(Argv[1], Test.Name) == 0)
+        {
+            const int32 FailuresBefore = GFailures;
+            Test.Run();
+            printf("%s %s\n", GFailures == FailuresBefore ? "PASS" : "FAIL", Test.Name);
+            Ran++;
+        }
+    }
+
+    if (Ran == 0)
+    {
+        fprintf(stderr, "Unknown test %s\n", Argv[1]);
+        return 1;
+    }
+    return GFailures == 0 ? 0 : 1;
+}
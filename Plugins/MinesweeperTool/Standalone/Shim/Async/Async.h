@@ -0,0 +1,46 @@
+// Async.h
+// Every execution mode runs the task on its own thread; the standalone build has no task graph
+#pragma once
+
+#include "CoreMinimal.h"
+#include <future>
+#include <thread>
+
+enum class EAsyncExecution { TaskGraph, TaskGraphMainThread, Thread, ThreadIfForkSafe, ThreadPool, LargeThreadPool };
+
+template<typename ResultType>
+class TFuture
+{
+public:
+	TFuture() = default;
+	explicit TFuture(std::shared_future<ResultType> InFuture) : Future(MoveTemp(InFuture)) {}
+
+	bool IsReady() const { return Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+	void Wait() const { Future.wait(); }
+	ResultType Get() const { return Future.get(); }
+
+private:
+	std::shared_future<ResultType> Future;
+};
+
+template<typename CallableType>
+auto Async(EAsyncExecution Execution, CallableType&& Callable) -> TFuture<decltype(Callable())>
+{
+	typedef decltype(Callable()) ResultType;
+	std::shared_ptr<std::promise<ResultType>> Promise = std::make_shared<std::promise<ResultType>>();
+	TFuture<ResultType> Future(Promise->get_future().share());
+
+	std::thread([Promise, Function = std::forward<CallableType>(Callable)]() mutable
+	{
+		if constexpr (std::is_void_v<ResultType>)
+		{
+			Function();
+			Promise->set_value();
+		}
+		else
+		{
+			Promise->set_value(Function());
+		}
+	}).detach();
+	return Future;
+}
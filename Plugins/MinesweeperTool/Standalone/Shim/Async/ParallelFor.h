@@ -0,0 +1,39 @@
+// ParallelFor.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include <thread>
+
+enum class EParallelForFlags { None = 0, Unbalanced = 1, BackgroundPriority = 2, ForceSingleThread = 4 };
+
+// Indices are handed out one at a time to a worker per hardware thread
+template<typename BodyType>
+void ParallelFor(int32 Num, BodyType&& Body, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	if (Flags == EParallelForFlags::ForceSingleThread || Num <= 1)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Body(Index);
+		}
+		return;
+	}
+
+	std::atomic<int32> NextIndex(0);
+	std::vector<std::thread> Workers;
+	const int32 NumWorkers = FMath::Min(Num, int32(FMath::Max(1u, std::thread::hardware_concurrency())));
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+	{
+		Workers.emplace_back([&NextIndex, &Body, Num]()
+		{
+			for (int32 Index = NextIndex++; Index < Num; Index = NextIndex++)
+			{
+				Body(Index);
+			}
+		});
+	}
+	for (std::thread& Worker : Workers)
+	{
+		Worker.join();
+	}
+}
@@ -0,0 +1,78 @@
+// Queue.h
+// Unreal's lock-free linked queue: producers swap themselves in at the head, the single consumer
+// follows the links from the tail. Both modes use the multi-producer path here.
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EQueueMode
+{
+	Mpsc,
+	Spsc
+};
+
+template<typename ItemType, EQueueMode Mode = EQueueMode::Spsc>
+class TQueue
+{
+public:
+	TQueue()
+	{
+		Tail = new FNode();
+		Head.store(Tail, std::memory_order_relaxed);
+	}
+
+	~TQueue()
+	{
+		while (Tail != nullptr)
+		{
+			FNode* Node = Tail;
+			Tail = Tail->NextNode.load(std::memory_order_relaxed);
+			delete Node;
+		}
+	}
+
+	TQueue(const TQueue&) = delete;
+	TQueue& operator=(const TQueue&) = delete;
+
+	bool Enqueue(const ItemType& Item) { return Push(new FNode(Item)); }
+	bool Enqueue(ItemType&& Item) { return Push(new FNode(MoveTemp(Item))); }
+
+	bool Dequeue(ItemType& OutItem)
+	{
+		FNode* Popped = Tail->NextNode.load(std::memory_order_acquire);
+		if (Popped == nullptr)
+		{
+			return false;
+		}
+
+		OutItem = MoveTemp(Popped->Item);
+		FNode* OldTail = Tail;
+		Tail = Popped;
+		Tail->Item = ItemType();
+		delete OldTail;
+		return true;
+	}
+
+	bool IsEmpty() const { return Tail->NextNode.load(std::memory_order_acquire) == nullptr; }
+
+private:
+	struct FNode
+	{
+		std::atomic<FNode*> NextNode{ nullptr };
+		ItemType Item;
+
+		FNode() = default;
+		explicit FNode(const ItemType& InItem) : Item(InItem) {}
+		explicit FNode(ItemType&& InItem) : Item(MoveTemp(InItem)) {}
+	};
+
+	bool Push(FNode* NewNode)
+	{
+		FNode* OldHead = Head.exchange(NewNode, std::memory_order_acq_rel);
+		OldHead->NextNode.store(NewNode, std::memory_order_release);
+		return true;
+	}
+
+	std::atomic<FNode*> Head;
+	FNode* Tail;
+};
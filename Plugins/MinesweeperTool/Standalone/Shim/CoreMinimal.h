@@ -0,0 +1,380 @@
+// CoreMinimal.h
+// The subset of Unreal's Core that MinesweeperCore uses, over the standard library, so the
+// engine can be built and profiled without Unreal. Anything that decides the board, such as
+// FRandomStream, follows Unreal bit for bit, so a seed gives the same board in both builds.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+typedef int8_t int8;
+typedef int16_t int16;
+typedef int32_t int32;
+typedef int64_t int64;
+typedef uint8_t uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef uint64_t uint64;
+typedef char TCHAR;
+typedef size_t SIZE_T;
+
+#define TEXT(Text) Text
+#define INDEX_NONE (-1)
+#define MAX_int32 (0x7fffffff)
+#define MAX_uint32 (0xffffffffu)
+#define MAX_dbl (1.7976931348623158e+308)
+#define UE_ARRAY_COUNT(Array) (sizeof(Array) / sizeof((Array)[0]))
+#define MINESWEEPERCORE_API
+
+#define check(Expr) do { if (!(Expr)) { fprintf(stderr, "Check failed: %s (%s:%d)\n", #Expr, __FILE__, __LINE__); abort(); } } while (0)
+
+// Container bounds checks are off unless asked for, as in Unreal's shipping configurations
+#if MINESWEEPER_STANDALONE_CHECK_BOUNDS
+	#define checkSlow(Expr) check(Expr)
+#else
+	#define checkSlow(Expr)
+#endif
+
+template<typename T> constexpr std::remove_reference_t<T>&& MoveTemp(T&& Value) { return static_cast<std::remove_reference_t<T>&&>(Value); }
+template<typename T> void Swap(T& A, T& B) { std::swap(A, B); }
+
+struct FMath
+{
+	template<typename T> static constexpr T Max(T A, T B) { return A > B ? A : B; }
+	template<typename T> static constexpr T Min(T A, T B) { return A < B ? A : B; }
+	template<typename T> static constexpr T Clamp(T Value, T MinValue, T MaxValue) { return Value < MinValue ? MinValue : (Value > MaxValue ? MaxValue : Value); }
+	template<typename T> static constexpr T DivideAndRoundUp(T Dividend, T Divisor) { return (Dividend + Divisor - 1) / Divisor; }
+	static int32 TruncToInt(float Value) { return int32(Value); }
+	static int32 CountBits(uint64 Bits) { return int32(__builtin_popcountll(Bits)); }
+	static uint64 CountTrailingZeros64(uint64 Value) { return Value == 0 ? 64 : uint64(__builtin_ctzll(Value)); }
+	static int32 Rand() { return rand(); }
+};
+
+struct FPlatformMisc
+{
+	static int32 NumberOfCores() { return FMath::Max(1, int32(std::thread::hardware_concurrency())); }
+	static int32 NumberOfCoresIncludingHyperthreads() { return NumberOfCores(); }
+};
+
+// Unreal's stream generator, kept exact so boards match the editor build
+class FRandomStream
+{
+public:
+	FRandomStream() : InitialSeed(0), Seed(0) {}
+	FRandomStream(int32 InSeed) : InitialSeed(InSeed), Seed(uint32(InSeed)) {}
+
+	void Initialize(int32 InSeed) { InitialSeed = InSeed; Seed = uint32(InSeed); }
+
+	float GetFraction() const
+	{
+		MutateSeed();
+		const uint32 Bits = 0x3F800000U | (Seed >> 9);
+		float Result;
+		memcpy(&Result, &Bits, sizeof(Result));
+		return Result - 1.0f;
+	}
+	float FRand() const { return GetFraction(); }
+	uint32 GetUnsignedInt() const { MutateSeed(); return Seed; }
+	int32 RandHelper(int32 A) const { return A > 0 ? FMath::Min(FMath::TruncToInt(GetFraction() * float(A)), A - 1) : 0; }
+	int32 RandRange(int32 Min, int32 Max) const { return Min + RandHelper(Max - Min + 1); }
+
+private:
+	void MutateSeed() const { Seed = (Seed * 196314165U) + 907633515U; }
+
+	int32 InitialSeed;
+	mutable uint32 Seed;
+};
+
+struct FMemory
+{
+	static void* Memcpy(void* Dest, const void* Src, SIZE_T Count) { return memcpy(Dest, Src, Count); }
+	static void* Memzero(void* Dest, SIZE_T Count) { return memset(Dest, 0, Count); }
+	static int32 Memcmp(const void* A, const void* B, SIZE_T Count) { return memcmp(A, B, Count); }
+};
+
+template<typename KeyType, typename ValueType>
+struct TPair
+{
+	KeyType Key;
+	ValueType Value;
+
+	TPair() = default;
+	TPair(const KeyType& InKey, const ValueType& InValue) : Key(InKey), Value(InValue) {}
+};
+
+template<int32 NumInlineElements> struct TInlineAllocator {};
+
+template<typename T> class TArrayView;
+
+// TArray over std::vector. TArray<bool> stores bytes, so elements stay addressable.
+template<typename T, typename Allocator = void>
+class TArray
+{
+	typedef std::conditional_t<std::is_same_v<T, bool>, uint8, T> FStorage;
+
+public:
+	TArray() = default;
+	TArray(std::initializer_list<T> List) : Elements(List.begin(), List.end()) {}
+
+	int32 Num() const { return int32(Elements.size()); }
+	bool IsEmpty() const { return Elements.empty(); }
+	T* GetData() { return reinterpret_cast<T*>(Elements.data()); }
+	const T* GetData() const { return reinterpret_cast<const T*>(Elements.data()); }
+	SIZE_T GetAllocatedSize() const { return Elements.capacity() * sizeof(FStorage); }
+
+	T& operator[](int32 Index) { checkSlow(Index >= 0 && Index < Num()); return GetData()[Index]; }
+	const T& operator[](int32 Index) const { checkSlow(Index >= 0 && Index < Num()); return GetData()[Index]; }
+	T& Last(int32 IndexFromEnd = 0) { return GetData()[Num() - 1 - IndexFromEnd]; }
+	const T& Last(int32 IndexFromEnd = 0) const { return GetData()[Num() - 1 - IndexFromEnd]; }
+
+	int32 Add(const T& Item) { Elements.push_back(Item); return Num() - 1; }
+	int32 Add(T&& Item) { Elements.push_back(MoveTemp(Item)); return Num() - 1; }
+	template<typename... ArgTypes> int32 Emplace(ArgTypes&&... Args) { Elements.emplace_back(std::forward<ArgTypes>(Args)...); return Num() - 1; }
+	T& AddDefaulted_GetRef() { Elements.emplace_back(); return Last(); }
+	T& Add_GetRef(T&& Item) { Elements.push_back(MoveTemp(Item)); return Last(); }
+	int32 AddZeroed(int32 Count = 1) { const int32 Index = Num(); Elements.resize(Index + Count); memset(static_cast<void*>(Elements.data() + Index), 0, sizeof(FStorage) * Count); return Index; }
+	void Append(const T* Items, int32 Count) { Elements.insert(Elements.end(), Items, Items + Count); }
+	T Pop(bool bAllowShrinking = true) { T Item = MoveTemp(Last()); Elements.pop_back(); return Item; }
+
+	// Unreal's Reset keeps the allocation, which the scratch buffers rely on
+	void Reset(int32 NewSize = 0) { Elements.clear(); Elements.reserve(NewSize); }
+	void Empty(int32 Slack = 0) { std::vector<FStorage>().swap(Elements); Elements.reserve(Slack); }
+	void Reserve(int32 Count) { Elements.reserve(Count); }
+	void Init(const T& Item, int32 Count) { Elements.assign(Count, FStorage(Item)); }
+	void SetNum(int32 Count, bool bAllowShrinking = true) { Elements.resize(Count); }
+	void SetNumUninitialized(int32 Count, bool bAllowShrinking = true) { Elements.resize(Count); }
+	void SetNumZeroed(int32 Count, bool bAllowShrinking = true) { const int32 OldNum = Num(); Elements.resize(Count); if (Count > OldNum) { memset(static_cast<void*>(Elements.data() + OldNum), 0, sizeof(FStorage) * (Count - OldNum)); } }
+	void RemoveAt(int32 Index, int32 Count = 1, bool bAllowShrinking = true) { Elements.erase(Elements.begin() + Index, Elements.begin() + Index + Count); }
+	int32 Find(const T& Item) const { const auto It = std::find(Elements.begin(), Elements.end(), Item); return It == Elements.end() ? INDEX_NONE : int32(It - Elements.begin()); }
+	bool Contains(const T& Item) const { return Find(Item) != INDEX_NONE; }
+	void Swap(int32 A, int32 B) { std::swap(Elements[A], Elements[B]); }
+	void Sort() { std::sort(begin(), end()); }
+	template<typename PredicateType> void Sort(PredicateType Predicate) { std::sort(begin(), end(), Predicate); }
+	// A binary heap with the smallest element on top, as Unreal's default predicate gives
+	void HeapPush(const T& Item) { Elements.push_back(Item); std::push_heap(begin(), end(), std::greater<T>()); }
+	void HeapPop(T& OutItem, bool bAllowShrinking = true) { std::pop_heap(begin(), end(), std::greater<T>()); OutItem = MoveTemp(Last()); Elements.pop_back(); }
+
+	bool operator==(const TArray& Other) const { return Elements == Other.Elements; }
+	bool operator!=(const TArray& Other) const { return Elements != Other.Elements; }
+
+	T* begin() { return GetData(); }
+	T* end() { return GetData() + Num(); }
+	const T* begin() const { return GetData(); }
+	const T* end() const { return GetData() + Num(); }
+
+private:
+	std::vector<FStorage> Elements;
+};
+
+template<typename T>
+class TArrayView
+{
+public:
+	TArrayView() : Data(nullptr), Count(0) {}
+	TArrayView(T* InData, int32 InCount) : Data(InData), Count(InCount) {}
+	template<typename OtherType, typename = std::enable_if_t<std::is_convertible_v<OtherType*, T*>>> TArrayView(const TArrayView<OtherType>& Other) : Data(Other.GetData()), Count(Other.Num()) {}
+	template<typename OtherType, typename Allocator> TArrayView(TArray<OtherType, Allocator>& Array) : Data(Array.GetData()), Count(Array.Num()) {}
+	template<typename OtherType, typename Allocator> TArrayView(const TArray<OtherType, Allocator>& Array) : Data(Array.GetData()), Count(Array.Num()) {}
+
+	int32 Num() const { return Count; }
+	T* GetData() const { return Data; }
+	T& operator[](int32 Index) const { checkSlow(Index >= 0 && Index < Count); return Data[Index]; }
+	T* begin() const { return Data; }
+	T* end() const { return Data + Count; }
+
+private:
+	T* Data;
+	int32 Count;
+};
+
+template<typename T> TArrayView<T> MakeArrayView(T* Data, int32 Count) { return TArrayView<T>(Data, Count); }
+
+inline uint32 HashCombine(uint32 A, uint32 B) { return A ^ (B + 0x9e3779b9 + (A << 6) + (A >> 2)); }
+
+struct FInt64Point
+{
+	int64 X = 0;
+	int64 Y = 0;
+
+	FInt64Point() = default;
+	FInt64Point(int64 InX, int64 InY) : X(InX), Y(InY) {}
+	bool operator==(const FInt64Point& Other) const { return X == Other.X && Y == Other.Y; }
+};
+
+inline uint32 GetTypeHash(const FInt64Point& Point) { return uint32(std::hash<int64>()(Point.X) * 31 + std::hash<int64>()(Point.Y)); }
+
+// TMap in insertion order, with the iterator removal the chunk caches use
+template<typename KeyType, typename ValueType>
+class TMap
+{
+	typedef TPair<KeyType, ValueType> FElement;
+	typedef typename std::list<FElement>::iterator FListIterator;
+	struct FHash { size_t operator()(const KeyType& Key) const { return GetTypeHash(Key); } };
+
+public:
+	class TIterator
+	{
+	public:
+		TIterator(TMap& InMap) : Map(InMap), It(InMap.Elements.begin()), bRemoved(false) {}
+		explicit operator bool() const { return It != Map.Elements.end(); }
+		TIterator& operator++() { if (!bRemoved) { ++It; } bRemoved = false; return *this; }
+		const KeyType& Key() const { return It->Key; }
+		ValueType& Value() const { return It->Value; }
+		void RemoveCurrent() { Map.Index.erase(It->Key); It = Map.Elements.erase(It); bRemoved = true; }
+
+	private:
+		TMap& Map;
+		FListIterator It;
+		bool bRemoved;
+	};
+
+	int32 Num() const { return int32(Index.size()); }
+	ValueType& Add(const KeyType& Key, ValueType&& Value) { ValueType& Slot = FindOrAdd(Key); Slot = MoveTemp(Value); return Slot; }
+	ValueType& FindOrAdd(const KeyType& Key)
+	{
+		const auto Found = Index.find(Key);
+		if (Found != Index.end())
+		{
+			return Found->second->Value;
+		}
+		Elements.emplace_back();
+		Elements.back().Key = Key;
+		Index.emplace(Key, std::prev(Elements.end()));
+		return Elements.back().Value;
+	}
+	ValueType* Find(const KeyType& Key) { const auto Found = Index.find(Key); return Found == Index.end() ? nullptr : &Found->second->Value; }
+	const ValueType* Find(const KeyType& Key) const { const auto Found = Index.find(Key); return Found == Index.end() ? nullptr : &Found->second->Value; }
+	int32 Remove(const KeyType& Key) { const auto Found = Index.find(Key); if (Found == Index.end()) { return 0; } Elements.erase(Found->second); Index.erase(Found); return 1; }
+	void Empty() { Index.clear(); Elements.clear(); }
+	void Reset() { Empty(); }
+	TIterator CreateIterator() { return TIterator(*this); }
+
+private:
+	std::list<FElement> Elements;
+	std::unordered_map<KeyType, FListIterator, FHash> Index;
+};
+
+class FString
+{
+public:
+	FString() = default;
+	FString(const TCHAR* Text) : Chars(Text ? Text : "") {}
+
+	const TCHAR* operator*() const { return Chars.c_str(); }
+	int32 Len() const { return int32(Chars.size()); }
+	bool IsEmpty() const { return Chars.empty(); }
+	void Reserve(int32 CharacterCount) { Chars.reserve(CharacterCount); }
+	FString operator/(const FString& Other) const { return FString((Chars + "/" + Other.Chars).c_str()); }
+	FString& operator+=(const FString& Other) { Chars += Other.Chars; return *this; }
+
+	static FString Printf(const TCHAR* Format, ...)
+	{
+		va_list Args;
+		va_start(Args, Format);
+		const int32 Length = vsnprintf(nullptr, 0, Format, Args);
+		va_end(Args);
+
+		std::string Buffer(Length + 1, '\0');
+		va_start(Args, Format);
+		vsnprintf(Buffer.data(), Buffer.size(), Format, Args);
+		va_end(Args);
+		return FString(Buffer.c_str());
+	}
+
+private:
+	std::string Chars;
+};
+
+struct FCString
+{
+	static int32 Atoi(const TCHAR* Text) { return atoi(Text); }
+	static float Atof(const TCHAR* Text) { return float(atof(Text)); }
+	static double Atod(const TCHAR* Text) { return atof(Text); }
+};
+
+// Log lines go to stdout, so benchmark results can be piped
+#define DEFINE_LOG_CATEGORY_STATIC(CategoryName, DefaultVerbosity, CompileTimeVerbosity)
+#define UE_LOG(CategoryName, Verbosity, Format, ...) do { printf(Format, ##__VA_ARGS__); printf("\n"); } while (0)
+
+enum class ESPMode { NotThreadSafe, ThreadSafe };
+
+// Shared pointers over std::shared_ptr, whose reference counts are always atomic
+template<typename T, ESPMode Mode = ESPMode::ThreadSafe>
+class TSharedRef
+{
+public:
+	explicit TSharedRef(std::shared_ptr<T> InPointer) : Pointer(MoveTemp(InPointer)) {}
+	template<typename OtherType> TSharedRef(const TSharedRef<OtherType, Mode>& Other) : Pointer(Other.Pointer) {}
+
+	T* operator->() const { return Pointer.get(); }
+	T& operator*() const { return *Pointer; }
+	T& Get() const { return *Pointer; }
+
+	std::shared_ptr<T> Pointer;
+};
+
+template<typename T, ESPMode Mode = ESPMode::ThreadSafe>
+class TSharedPtr
+{
+public:
+	TSharedPtr() = default;
+	TSharedPtr(std::nullptr_t) {}
+	template<typename OtherType> TSharedPtr(const TSharedPtr<OtherType, Mode>& Other) : Pointer(Other.Pointer) {}
+	template<typename OtherType> TSharedPtr(TSharedPtr<OtherType, Mode>&& Other) : Pointer(MoveTemp(Other.Pointer)) {}
+	template<typename OtherType> TSharedPtr(const TSharedRef<OtherType, Mode>& Other) : Pointer(Other.Pointer) {}
+
+	bool IsValid() const { return Pointer != nullptr; }
+	bool IsUnique() const { return Pointer.use_count() == 1; }
+	T* Get() const { return Pointer.get(); }
+	T* operator->() const { return Pointer.get(); }
+	T& operator*() const { return *Pointer; }
+	void Reset() { Pointer.reset(); }
+	TSharedRef<T, Mode> ToSharedRef() const { check(IsValid()); return TSharedRef<T, Mode>(Pointer); }
+
+	bool operator==(const TSharedPtr& Other) const { return Pointer == Other.Pointer; }
+	bool operator!=(const TSharedPtr& Other) const { return Pointer != Other.Pointer; }
+
+	std::shared_ptr<T> Pointer;
+};
+
+template<typename T, ESPMode Mode = ESPMode::ThreadSafe, typename... ArgTypes>
+TSharedRef<T, Mode> MakeShared(ArgTypes&&... Args)
+{
+	return TSharedRef<T, Mode>(std::make_shared<T>(std::forward<ArgTypes>(Args)...));
+}
+
+template<typename T>
+class TUniquePtr : public std::unique_ptr<T>
+{
+public:
+	using std::unique_ptr<T>::unique_ptr;
+	TUniquePtr(std::unique_ptr<T>&& Other) : std::unique_ptr<T>(MoveTemp(Other)) {}
+
+	bool IsValid() const { return this->get() != nullptr; }
+	T* Get() const { return this->get(); }
+	void Reset(T* NewPointer = nullptr) { this->reset(NewPointer); }
+};
+
+template<typename T, typename... ArgTypes>
+TUniquePtr<T> MakeUnique(ArgTypes&&... Args)
+{
+	return TUniquePtr<T>(std::make_unique<T>(std::forward<ArgTypes>(Args)...));
+}
+
+template<typename FunctionType> using TFunction = std::function<FunctionType>;
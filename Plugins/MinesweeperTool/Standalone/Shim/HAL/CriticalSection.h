@@ -0,0 +1,37 @@
+// CriticalSection.h
+#pragma once
+
+#include <mutex>
+#include <shared_mutex>
+
+class FRWLock
+{
+public:
+	void ReadLock() { Mutex.lock_shared(); }
+	void ReadUnlock() { Mutex.unlock_shared(); }
+	void WriteLock() { Mutex.lock(); }
+	void WriteUnlock() { Mutex.unlock(); }
+
+private:
+	std::shared_mutex Mutex;
+};
+
+class FCriticalSection
+{
+public:
+	void Lock() { Mutex.lock(); }
+	void Unlock() { Mutex.unlock(); }
+
+private:
+	std::mutex Mutex;
+};
+
+class FScopeLock
+{
+public:
+	explicit FScopeLock(FCriticalSection* InSection) : Section(InSection) { Section->Lock(); }
+	~FScopeLock() { Section->Unlock(); }
+
+private:
+	FCriticalSection* Section;
+};
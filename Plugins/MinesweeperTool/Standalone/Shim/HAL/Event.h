@@ -0,0 +1,35 @@
+// Event.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// An auto-reset event: a Trigger with nobody waiting releases the next Wait
+class FEvent
+{
+public:
+	void Trigger()
+	{
+		{
+			std::lock_guard<std::mutex> Guard(Mutex);
+			bTriggered = true;
+		}
+		Condition.notify_one();
+	}
+
+	bool Wait(uint32 WaitTimeMs = ~0u)
+	{
+		std::unique_lock<std::mutex> Guard(Mutex);
+		const auto IsTriggered = [this]() { return bTriggered; };
+		const bool bWoken = WaitTimeMs == ~0u ? (Condition.wait(Guard, IsTriggered), true) : Condition.wait_for(Guard, std::chrono::milliseconds(WaitTimeMs), IsTriggered);
+		bTriggered = false;
+		return bWoken;
+	}
+
+private:
+	std::mutex Mutex;
+	std::condition_variable Condition;
+	bool bTriggered = false;
+};
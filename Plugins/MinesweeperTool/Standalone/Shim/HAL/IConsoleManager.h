@@ -0,0 +1,45 @@
+// IConsoleManager.h
+// Console commands register by name so the bench executable can run them from its command line
+#pragma once
+
+#include "CoreMinimal.h"
+#include <map>
+
+class FConsoleCommandWithArgsDelegate
+{
+public:
+	template<typename FunctionType>
+	static FConsoleCommandWithArgsDelegate CreateStatic(FunctionType Function)
+	{
+		FConsoleCommandWithArgsDelegate Delegate;
+		Delegate.Function = Function;
+		return Delegate;
+	}
+
+	void Execute(const TArray<FString>& Args) const { Function(Args); }
+
+private:
+	TFunction<void(const TArray<FString>&)> Function;
+};
+
+class FAutoConsoleCommand
+{
+public:
+	FAutoConsoleCommand(const TCHAR* Name, const TCHAR* Help, const FConsoleCommandWithArgsDelegate& Command)
+	{
+		GetRegistry()[Name] = FEntry{ Help, Command };
+	}
+
+	struct FEntry
+	{
+		const TCHAR* Help;
+		FConsoleCommandWithArgsDelegate Command;
+	};
+
+	// Sorted by name, for listing
+	static std::map<std::string, FEntry>& GetRegistry()
+	{
+		static std::map<std::string, FEntry> Registry;
+		return Registry;
+	}
+};
@@ -0,0 +1,53 @@
+// PlatformFileManager.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include <filesystem>
+
+class IFileHandle
+{
+public:
+	explicit IFileHandle(FILE* InFile) : File(InFile) {}
+	~IFileHandle() { fclose(File); }
+
+	bool Seek(int64 Position) { return fseeko(File, Position, SEEK_SET) == 0; }
+	bool Read(uint8* Destination, int64 BytesToRead) { return fread(Destination, 1, BytesToRead, File) == size_t(BytesToRead); }
+	bool Write(const uint8* Source, int64 BytesToWrite) { return fwrite(Source, 1, BytesToWrite, File) == size_t(BytesToWrite); }
+
+private:
+	FILE* File;
+};
+
+class IPlatformFile
+{
+public:
+	IFileHandle* OpenWrite(const TCHAR* Filename, bool bAppend = false, bool bAllowRead = false)
+	{
+		FILE* File = fopen(Filename, bAppend ? (bAllowRead ? "a+b" : "ab") : (bAllowRead ? "w+b" : "wb"));
+		return File ? new IFileHandle(File) : nullptr;
+	}
+
+	bool CreateDirectoryTree(const TCHAR* Directory)
+	{
+		std::error_code Error;
+		std::filesystem::create_directories(Directory, Error);
+		return !Error;
+	}
+
+	bool DeleteFile(const TCHAR* Filename) { return remove(Filename) == 0; }
+};
+
+class FPlatformFileManager
+{
+public:
+	static FPlatformFileManager& Get()
+	{
+		static FPlatformFileManager Manager;
+		return Manager;
+	}
+
+	IPlatformFile& GetPlatformFile() { return PlatformFile; }
+
+private:
+	IPlatformFile PlatformFile;
+};
@@ -0,0 +1,16 @@
+// PlatformProcess.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Event.h"
+#include <chrono>
+#include <thread>
+
+struct FPlatformProcess
+{
+	static void Sleep(float Seconds) { std::this_thread::sleep_for(std::chrono::duration<float>(Seconds)); }
+
+	// Unreal pools its events; here each one is allocated, and always auto-reset
+	static FEvent* GetSynchEventFromPool(bool bIsManualReset = false) { return new FEvent(); }
+	static void ReturnSynchEventToPool(FEvent* Event) { delete Event; }
+};
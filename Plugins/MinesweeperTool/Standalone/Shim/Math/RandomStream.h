@@ -0,0 +1,5 @@
+// RandomStream.h
+// FMath and FRandomStream live in the shim's CoreMinimal.h
+#pragma once
+
+#include "CoreMinimal.h"
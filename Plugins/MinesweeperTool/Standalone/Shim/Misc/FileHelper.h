@@ -0,0 +1,18 @@
+// FileHelper.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FFileHelper
+{
+	static bool SaveStringToFile(const FString& String, const TCHAR* Filename)
+	{
+		FILE* File = fopen(Filename, "wb");
+		if (!File)
+		{
+			return false;
+		}
+		const bool bWritten = fwrite(*String, 1, String.Len(), File) == size_t(String.Len());
+		return fclose(File) == 0 && bWritten;
+	}
+};
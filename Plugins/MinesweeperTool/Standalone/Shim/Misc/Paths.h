@@ -0,0 +1,25 @@
+// Paths.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include <string>
+
+struct FPaths
+{
+	// Saved files go under the working directory the bench is run from
+	static FString ProjectSavedDir() { return FString(TEXT("Saved")); }
+
+	static FString GetPath(const FString& Path)
+	{
+		const std::string Text(*Path);
+		const size_t Slash = Text.rfind('/');
+		return FString(Slash == std::string::npos ? "" : Text.substr(0, Slash).c_str());
+	}
+
+	static FString CreateTempFilename(const TCHAR* Path, const TCHAR* Prefix = TEXT(""), const TCHAR* Extension = TEXT(".tmp"))
+	{
+		static std::atomic<uint32> Counter(0);
+		return FString::Printf(TEXT("%s/%s%08X%s"), Path, Prefix, unsigned(Counter++ ^ uint32(rand())), Extension);
+	}
+};
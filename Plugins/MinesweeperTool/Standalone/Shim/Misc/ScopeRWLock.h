@@ -0,0 +1,24 @@
+// ScopeRWLock.h
+#pragma once
+
+#include "HAL/CriticalSection.h"
+
+class FReadScopeLock
+{
+public:
+	explicit FReadScopeLock(FRWLock& InLock) : Lock(InLock) { Lock.ReadLock(); }
+	~FReadScopeLock() { Lock.ReadUnlock(); }
+
+private:
+	FRWLock& Lock;
+};
+
+class FWriteScopeLock
+{
+public:
+	explicit FWriteScopeLock(FRWLock& InLock) : Lock(InLock) { Lock.WriteLock(); }
+	~FWriteScopeLock() { Lock.WriteUnlock(); }
+
+private:
+	FRWLock& Lock;
+};
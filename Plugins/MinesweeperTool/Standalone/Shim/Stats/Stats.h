@@ -0,0 +1,9 @@
+// Stats.h
+// Stats compile away in the standalone build; the values are still evaluated
+#pragma once
+
+#define DECLARE_STATS_GROUP(GroupDesc, GroupId, GroupCat)
+#define DECLARE_FLOAT_ACCUMULATOR_STAT(CounterName, StatId, GroupId)
+#define DECLARE_DWORD_ACCUMULATOR_STAT(CounterName, StatId, GroupId)
+#define SET_FLOAT_STAT(StatId, Value) (void)(Value)
+#define SET_DWORD_STAT(StatId, Value) (void)(Value)